@@ -5,18 +5,38 @@ void Heap<T, Compare>::swap(Heap<T, Compare> &other) noexcept {
     std::swap(data, other.data);
     std::swap(size, other.size);
     std::swap(capacity, other.capacity);
+    std::swap(resource, other.resource);
 }
 
 template <typename T, typename Compare>
-void Heap<T, Compare>::free(value_type *data_to_free, size_type destructor_calls) noexcept {
+typename Heap<T, Compare>::value_type *Heap<T, Compare>::allocate(size_type new_capacity) {
+    return static_cast<value_type *>(
+        resource->allocate(sizeof(value_type) * new_capacity, alignof(value_type)));
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::deallocate(value_type *data_to_free, size_type allocated_capacity) noexcept {
+    if (data_to_free != nullptr) {
+        resource->deallocate(data_to_free, sizeof(value_type) * allocated_capacity,
+                             alignof(value_type));
+    }
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::destroy(value_type *data_to_destroy, size_type destructor_calls) noexcept {
     if (!std::is_trivially_destructible_v<value_type>) {
         size_type destroyed_objects = 0;
         while (destroyed_objects < destructor_calls) {
-            (data_to_free + destroyed_objects)->~value_type();
+            (data_to_destroy + destroyed_objects)->~value_type();
             ++destroyed_objects;
         }
     }
-    ::operator delete(data_to_free);
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::free() noexcept {
+    destroy(data, size);
+    deallocate(data, capacity);
 }
 
 template <typename T, typename Compare>
@@ -27,7 +47,7 @@ void Heap<T, Compare>::uninitializedCopy(value_type *copy_to, const Heap<T, Comp
             new (copy_to + copied_objects) value_type(copy_from.data[copied_objects]);
         }
     } catch (...) {
-        free(copy_to, copied_objects);
+        destroy(copy_to, copied_objects);
         throw;
     }
 }
@@ -41,7 +61,7 @@ void Heap<T, Compare>::uninitializedCopy(value_type *copy_to, const value_type *
             new (copy_to + copied_objects) value_type(copy_from[copied_objects]);
         }
     } catch (...) {
-        free(copy_to, copied_objects);
+        destroy(copy_to, copied_objects);
         throw;
     }
 }
@@ -67,19 +87,21 @@ Heap<T, Compare>::getParent(size_type index) const noexcept {
 template <typename T, typename Compare>
 void Heap<T, Compare>::resize() {
     size_type new_capacity = capacity > 0 ? capacity * 2 : capacity + 1;
-    value_type *new_data =
-        reinterpret_cast<value_type *>(::operator new(sizeof(value_type) * new_capacity));
-    if (std::is_move_constructible_v<value_type>) {
-        size_type moved_objects = 0;
-        while (moved_objects < size) {
+    value_type *new_data = allocate(new_capacity);
+    if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+        for (size_type moved_objects = 0; moved_objects < size; ++moved_objects) {
             new (new_data + moved_objects) value_type(std::move(data[moved_objects]));
-            ++moved_objects;
         }
-        ::operator delete(data);
     } else {
-        uninitializedCopy(new_data, *this);
-        free(data, size);
+        // A throwing move could leave both buffers half-moved, copying keeps the old one intact
+        try {
+            uninitializedCopy(new_data, *this);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
     }
+    free();
     data = new_data;
     capacity = new_capacity;
 }
@@ -122,57 +144,72 @@ void Heap<T, Compare>::siftingUp(size_type index) noexcept(
 
 template <typename T, typename Compare>
 void Heap<T, Compare>::makeHeap() noexcept(std::is_nothrow_swappable_v<T>) {
-    for (size_type i = (size / 2 - 1); i > 0; --i) {
-        siftingDown(i);
+    // Parents of the last element and everything before it, the root included
+    for (size_type i = size / 2; i > 0; --i) {
+        siftingDown(i - 1);
     }
 }
 
 template <typename T, typename Compare>
-Heap<T, Compare>::Heap() : data(nullptr), size(0), capacity(0), comparator(Compare()) {}
+Heap<T, Compare>::Heap()
+    : data(nullptr), size(0), capacity(0), comparator(Compare()),
+      resource(std::pmr::get_default_resource()) {}
 
 template <typename T, typename Compare>
-Heap<T, Compare>::Heap(const size_type capacity)
-    : data(reinterpret_cast<value_type *>(::operator new(sizeof(value_type) * capacity))), size(0),
-      capacity(capacity), comparator(Compare()) {}
+Heap<T, Compare>::Heap(const size_type capacity, std::pmr::memory_resource *resource)
+    : data(nullptr), size(0), capacity(capacity), comparator(Compare()), resource(resource) {
+    data = allocate(capacity);
+}
 
 template <typename T, typename Compare>
-Heap<T, Compare>::Heap(value_type *construct_from_data, size_type size)
-    : data(reinterpret_cast<value_type *>(::operator new(sizeof(value_type) * size))), size(size),
-      capacity(size), comparator(Compare()) {
-    uninitializedCopy(data, construct_from_data, size);
+Heap<T, Compare>::Heap(value_type *construct_from_data, size_type size,
+                       std::pmr::memory_resource *resource)
+    : data(nullptr), size(0), capacity(size), comparator(Compare()), resource(resource) {
+    data = allocate(capacity);
+    // The destructor doesn't run if a constructor throws
+    try {
+        uninitializedCopy(data, construct_from_data, size);
+    } catch (...) {
+        deallocate(data, capacity);
+        throw;
+    }
+    this->size = size;
+    makeHeap();
 }
 
 template <typename T, typename Compare>
 Heap<T, Compare>::Heap(const Heap<T, Compare> &other)
-    : data(reinterpret_cast<value_type *>(::operator new(sizeof(value_type) * other.capacity))),
-      size(other.size), capacity(other.capacity), comparator(Compare()) {
-    uninitializedCopy(data, other);
+    : data(nullptr), size(0), capacity(other.capacity), comparator(Compare()),
+      resource(other.resource) {
+    data = allocate(capacity);
+    try {
+        uninitializedCopy(data, other);
+    } catch (...) {
+        deallocate(data, capacity);
+        throw;
+    }
+    size = other.size;
 }
 
 template <typename T, typename Compare>
 Heap<T, Compare> &Heap<T, Compare>::operator=(const Heap<T, Compare> &other) {
     if (this != &other) {
-        value_type *new_data =
-            reinterpret_cast<value_type *>(::operator new(sizeof(value_type) * other.capacity));
-        uninitializedCopy(new_data, other);
-        free(data, size);
-        data = new_data;
-        size = other.size;
-        capacity = other.capacity;
+        Heap<T, Compare> copy(other);
+        swap(copy);
     }
     return *this;
 }
 
 template <typename T, typename Compare>
 Heap<T, Compare>::Heap(Heap &&other) noexcept
-    : data(nullptr), size(0), capacity(0), comparator(Compare()) {
+    : data(nullptr), size(0), capacity(0), comparator(Compare()), resource(other.resource) {
     swap(other);
 }
 
 template <typename T, typename Compare>
 Heap<T, Compare> &Heap<T, Compare>::operator=(Heap<T, Compare> &&other) noexcept {
     if (this != &other) {
-        free(data, size);
+        free();
         data = nullptr;
         size = 0;
         capacity = 0;
@@ -183,7 +220,7 @@ Heap<T, Compare> &Heap<T, Compare>::operator=(Heap<T, Compare> &&other) noexcept
 
 template <typename T, typename Compare>
 Heap<T, Compare>::~Heap() {
-    free(data, size);
+    free();
 }
 
 // Element access
@@ -206,13 +243,22 @@ template <typename T, typename Compare>
     return size;
 }
 
+template <typename T, typename Compare>
+[[nodiscard]] MemoryUsage Heap<T, Compare>::memoryUsage() const noexcept {
+    return {sizeof(value_type) * size, sizeof(value_type) * (capacity - size), sizeof(*this)};
+}
+
 // Modifiers
 template <typename T, typename Compare>
 void Heap<T, Compare>::push(const value_type &value) {
     if (size == capacity) {
+        // value may be an element of this heap, so it's copied before the old buffer is freed
+        value_type value_copy(value);
         this->resize();
+        new (data + size) value_type(std::move(value_copy));
+    } else {
+        new (data + size) value_type(value);
     }
-    new (data + size) value_type(value);
     ++size;
     siftingUp(size - 1);
 }
@@ -1,10 +1,14 @@
 #ifndef KTH_HEAP
 #define KTH_HEAP
 
+#include "../../MemoryUsage/MemoryUsage.h"
 #include "../Compare/Compare.h"
+#include <memory_resource>
 #include <stdexcept>
 #include <type_traits>
 
+// Binary heap on an array from a std::pmr::memory_resource, the heap by default
+// Copies and moves use the resource of the source
 template <typename T, typename Compare>
 class Heap {
 private:
@@ -18,10 +22,17 @@ private:
     size_type size;
     size_type capacity;
     value_compare comparator;
+    std::pmr::memory_resource *resource;
 
     void swap(Heap<T, Compare> &other) noexcept;
 
-    static void free(value_type *data_to_free, size_type destructor_calls) noexcept;
+    [[nodiscard]] value_type *allocate(size_type new_capacity);
+
+    void deallocate(value_type *data_to_free, size_type allocated_capacity) noexcept;
+
+    static void destroy(value_type *data_to_destroy, size_type destructor_calls) noexcept;
+
+    void free() noexcept;
 
     static void uninitializedCopy(value_type *copy_to, const Heap<T, Compare> &copy_from);
 
@@ -44,9 +55,11 @@ private:
 public:
     Heap();
 
-    explicit Heap(size_type capacity);
+    explicit Heap(size_type capacity,
+                  std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
-    Heap(value_type *construct_from_data, size_type size);
+    Heap(value_type *construct_from_data, size_type size,
+         std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
     Heap(const Heap<T, Compare> &other);
 
@@ -66,6 +79,9 @@ public:
 
     [[nodiscard]] size_type getSize() const noexcept;
 
+    // The array past size is reserved, the object itself is the only overhead
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept;
+
     // Modifiers
     void push(const value_type &value);
 
@@ -1,12 +1,16 @@
 #ifndef IS_BTREE_MAP
 #define IS_BTREE_MAP
 
+#include "../MemoryUsage/MemoryUsage.h"
 #include <cstddef>
 #include <iterator>
+#include <memory_resource>
+#include <utility>
 
 // Implementation of map using AA Tree
 // The comparator must satisfy strict weak ordering relation
-// TODO try to implement custom Allocator
+// Nodes and values come from a std::pmr::memory_resource, the heap by default. Copies and moves
+// use the resource of the source
 template <typename Key, typename T, typename Compare>
 class Map {
 private:
@@ -28,33 +32,30 @@ public:
     using iterator = Iterator;
     using const_iterator = ConstIterator;
 
-    Map()
+    Map() : Map(std::pmr::get_default_resource()) {}
+
+    explicit Map(std::pmr::memory_resource *resource)
         : root(nullptr), b_iter(Iterator(nullptr)), e_iter(Iterator(nullptr)), size(0),
-          comparator(Compare()) {}
+          comparator(Compare()), resource(resource) {}
 
     Map(const Map &other)
-        : root(other.root == nullptr ? nullptr : new Node(*other.root)),
-          b_iter(Iterator(beginNode(root))), e_iter(nullptr), size(other.size),
-          comparator(Compare()) {}
+        : root(nullptr), b_iter(Iterator(nullptr)), e_iter(nullptr), size(other.size),
+          comparator(Compare()), resource(other.resource) {
+        root = other.root == nullptr ? nullptr : copyTree(other.root, nullptr);
+        b_iter = Iterator(beginNode(root));
+    }
 
     Map &operator=(const Map &other) {
         if (this != &other) {
-            delete root;
-            root = nullptr;
-            size = 0;
-            b_iter = Iterator(nullptr);
-            if (other.root != nullptr) {
-                root = new Node(*other.root);
-                b_iter = Iterator(beginNode(root));
-                size = other.size;
-            }
+            Map copy(other);
+            *this = std::move(copy);
         }
         return *this;
     }
 
     Map(Map &&other) noexcept
         : root(other.root), b_iter(other.b_iter), e_iter(nullptr), size(other.size),
-          comparator(Compare()) {
+          comparator(Compare()), resource(other.resource) {
         other.root = nullptr;
         other.b_iter = Iterator(nullptr);
         other.size = 0;
@@ -62,9 +63,11 @@ public:
 
     Map &operator=(Map &&other) noexcept {
         if (this != &other) {
+            destroyTree(root);
             root = other.root;
             b_iter = other.b_iter;
             size = other.size;
+            resource = other.resource;
             other.root = nullptr;
             other.b_iter = Iterator(nullptr);
             other.size = 0;
@@ -73,7 +76,7 @@ public:
     }
 
     ~Map() {
-        delete root;
+        destroyTree(root);
         root = nullptr;
         b_iter = Iterator(nullptr);
         size = 0;
@@ -97,6 +100,11 @@ public:
 
     [[nodiscard]] size_type getSize() const noexcept { return size; }
 
+    // Every element is a separately allocated value plus a Node linking it, the Node is overhead
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        return {sizeof(value_type) * size, 0, sizeof(*this) + sizeof(Node) * size};
+    }
+
     // Modifiers
 
     // Return a pair consisting of an iterator to the inserted element (or to the element that
@@ -107,7 +115,7 @@ public:
         if ((parent != nullptr) && (parent->value->first == value.first)) {
             return std::pair{Iterator(parent), false};
         }
-        Node *new_node = new Node({new value_type(value), nullptr, nullptr, parent, 1});
+        Node *new_node = createNode(value, parent);
         ++size;
         if (parent == nullptr) {
             root = new_node;
@@ -145,17 +153,17 @@ public:
         if ((parent != nullptr) && (parent->value->first == value.first)) {
             return std::pair{Iterator(parent), false};
         }
-        Node *new_node = new Node({new value_type(std::move(value)), nullptr, nullptr, parent, 1});
+        Node *new_node = createNode(std::move(value), parent);
         ++size;
         if (parent == nullptr) {
             root = new_node;
             b_iter = Iterator(root);
         } else {
-            if (comparator(value.first, b_iter->first)) {
+            if (comparator(new_node->value->first, b_iter->first)) {
                 b_iter = Iterator(new_node);
             }
             Node *rebalance_node = nullptr;
-            if (comparator(value.first, parent->value->first)) {
+            if (comparator(new_node->value->first, parent->value->first)) {
                 parent->left = new_node;
                 rebalance_node = parent;
             } else {
@@ -205,12 +213,11 @@ public:
                     rebalance_node->right = right_child;
                 }
                 std::swap(current_node->value, next_node->value);
-                current_node->value->second = std::move(next_node->value->second);
                 --size;
                 next_node->left = nullptr;
                 next_node->right = nullptr;
                 next_node->parent = nullptr;
-                delete next_node;
+                destroyNode(next_node);
             }
             bool is_level_changed = true;
             while ((rebalance_node != nullptr) && is_level_changed) {
@@ -252,6 +259,7 @@ private:
     iterator e_iter;
     size_type size;
     key_compare comparator;
+    std::pmr::memory_resource *resource;
 
     struct Node {
         Map::pointer value;
@@ -262,30 +270,6 @@ private:
 
         Node(Map::pointer value, Node *left, Node *right, Node *parent, Map::size_type level)
             : value(value), left(left), right(right), parent(parent), level(level) {}
-
-        Node(const Node &other)
-            : value(new value_type(*(other.value))), left(nullptr), right(nullptr), parent(nullptr),
-              level(other.level) {
-            if (other.left != nullptr) {
-                left = new Node(*other.left);
-                left->parent = this;
-            }
-            if (other.right != nullptr) {
-                right = new Node(*other.right);
-                right->parent = this;
-            }
-        }
-
-        ~Node() {
-            delete value;
-            value = nullptr;
-            delete left;
-            delete right;
-            left = nullptr;
-            right = nullptr;
-            parent = nullptr;
-            level = 0;
-        }
     };
 
     class Iterator {
@@ -487,7 +471,7 @@ private:
         node_to_erase->left = nullptr;
         node_to_erase->right = nullptr;
         node_to_erase->parent = nullptr;
-        delete node_to_erase;
+        destroyNode(node_to_erase);
         return parent;
     }
 
@@ -535,12 +519,69 @@ private:
         return parent;
     }
 
+    // Leaf node owning a copy of value, nothing leaks if either allocation throws
+    template <typename Value>
+    [[nodiscard]] Node *createNode(Value &&value, Node *parent) {
+        pointer new_value =
+            static_cast<pointer>(resource->allocate(sizeof(value_type), alignof(value_type)));
+        try {
+            new (new_value) value_type(std::forward<Value>(value));
+        } catch (...) {
+            resource->deallocate(new_value, sizeof(value_type), alignof(value_type));
+            throw;
+        }
+        Node *new_node = nullptr;
+        try {
+            new_node = static_cast<Node *>(resource->allocate(sizeof(Node), alignof(Node)));
+        } catch (...) {
+            new_value->~value_type();
+            resource->deallocate(new_value, sizeof(value_type), alignof(value_type));
+            throw;
+        }
+        return new (new_node) Node(new_value, nullptr, nullptr, parent, 1);
+    }
+
+    // Node was allocated after its value and is released before it, in LIFO order
+    void destroyNode(Node *node) noexcept {
+        pointer value = node->value;
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+        value->~value_type();
+        resource->deallocate(value, sizeof(value_type), alignof(value_type));
+    }
+
+    void destroyTree(Node *node) noexcept {
+        if (node == nullptr) {
+            return;
+        }
+        destroyTree(node->left);
+        destroyTree(node->right);
+        destroyNode(node);
+    }
+
+    // Copy of the subtree of other, nothing leaks if a copy throws
+    [[nodiscard]] Node *copyTree(const Node *other, Node *parent) {
+        Node *node = createNode(*other->value, parent);
+        node->level = other->level;
+        try {
+            if (other->left != nullptr) {
+                node->left = copyTree(other->left, node);
+            }
+            if (other->right != nullptr) {
+                node->right = copyTree(other->right, node);
+            }
+        } catch (...) {
+            destroyTree(node);
+            throw;
+        }
+        return node;
+    }
+
     // return a pointer to the node containing the key, return nullptr if such a key does not exist
     // TODO add noexcept condition for Compare class
     [[nodiscard]] Node *findNode(const key_type &search_key) const noexcept {
         Node *node = root;
         while (node != nullptr) {
-            const key_type key = node->value->first;
+            const key_type &key = node->value->first;
             if (!(comparator(key, search_key)) && !(comparator(search_key, key))) {
                 break;
             }
@@ -560,7 +601,7 @@ private:
         Node *node = root;
         while (node != nullptr) {
             parent = node;
-            const key_type key = node->value->first;
+            const key_type &key = node->value->first;
             if (!(comparator(key, search_key)) && !(comparator(search_key, key))) {
                 break;
             }
@@ -0,0 +1,25 @@
+#ifndef MEMORY_USAGE
+#define MEMORY_USAGE
+#include <cstddef>
+
+// Bytes a container holds, as reported by its memoryUsage()
+// live_bytes are the stored elements, reserved_bytes are allocated for elements but not used yet
+// (growth slack), overhead_bytes are the rest: the container object itself, node links and
+// per-element bookkeeping
+// Headers and rounding of the memory resource aren't visible to the container and aren't counted
+struct MemoryUsage {
+    std::size_t live_bytes = 0;
+    std::size_t reserved_bytes = 0;
+    std::size_t overhead_bytes = 0;
+
+    [[nodiscard]] std::size_t total() const noexcept { return live_bytes + reserved_bytes + overhead_bytes; }
+
+    MemoryUsage &operator+=(const MemoryUsage &other) noexcept {
+        live_bytes += other.live_bytes;
+        reserved_bytes += other.reserved_bytes;
+        overhead_bytes += other.overhead_bytes;
+        return *this;
+    }
+};
+
+#endif // MEMORY_USAGE
@@ -0,0 +1,281 @@
+#ifndef MIN_MAX_QUEUE_BANK
+#define MIN_MAX_QUEUE_BANK
+#include "../Stack/Stack.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Many small min/max windows (Queue<BasicMinMaxNode<T>>) sharing one chunked arena
+// Every window keeps its first nodes inline and moves to an arena block only when it outgrows
+// them. Both stacks of a window live in one block: push stack grows from the start of the block,
+// pop stack grows from its end, so a flip is one backward pass inside the block.
+// Blocks are rounded to powers of two, released blocks are kept in per size free lists.
+template <typename T>
+class BasicMinMaxQueueBank {
+private:
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Min/max queue needs an arithmetic type");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = min_max_difference_t<T>;
+    using Node = BasicMinMaxNode<T>;
+
+    static constexpr std::uint32_t kInlineCapacity = 2;
+    static constexpr size_type kChunkBytes = 64 * 1024;
+    static constexpr size_type kSizeClasses = 32;
+
+    struct Window {
+        // nullptr while nodes are stored inline
+        Node *nodes;
+        std::uint32_t capacity;
+        std::uint32_t push_size;
+        std::uint32_t pop_size;
+        Node inline_nodes[kInlineCapacity];
+    };
+
+    // Released blocks are linked through their first bytes
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    // Blocks are carved one after another from chunks aligned for any fundamental type
+    static constexpr size_type kBlockAlignment =
+        alignof(Node) > alignof(FreeBlock) ? alignof(Node) : alignof(FreeBlock);
+
+    Window *windows;
+    size_type windows_count;
+    size_type windows_capacity;
+    Stack<char *> chunks;
+    char *chunk_pointer;
+    size_type chunk_left;
+    size_type arena_bytes;
+    FreeBlock *free_blocks[kSizeClasses];
+
+    [[nodiscard]] static size_type sizeClass(std::uint32_t capacity) noexcept {
+        size_type size_class = 0;
+        while ((std::uint32_t{1} << size_class) < capacity) {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    [[nodiscard]] Node *allocateBlock(std::uint32_t capacity) {
+        size_type size_class = sizeClass(capacity);
+        if (free_blocks[size_class] != nullptr) {
+            FreeBlock *block = free_blocks[size_class];
+            free_blocks[size_class] = block->next;
+            return reinterpret_cast<Node *>(block);
+        }
+        size_type block_bytes = sizeof(Node) * capacity;
+        if (block_bytes < sizeof(FreeBlock)) {
+            block_bytes = sizeof(FreeBlock);
+        }
+        block_bytes = (block_bytes + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+        if (block_bytes > chunk_left) {
+            size_type chunk_bytes = block_bytes > kChunkBytes ? block_bytes : kChunkBytes;
+            char *chunk = static_cast<char *>(::operator new(chunk_bytes));
+            try {
+                chunks.push(chunk);
+            } catch (...) {
+                ::operator delete(chunk);
+                throw;
+            }
+            arena_bytes += chunk_bytes;
+            chunk_pointer = chunk;
+            chunk_left = chunk_bytes;
+        }
+        char *block = chunk_pointer;
+        chunk_pointer += block_bytes;
+        chunk_left -= block_bytes;
+        return reinterpret_cast<Node *>(block);
+    }
+
+    void releaseBlock(Node *nodes, std::uint32_t capacity) noexcept {
+        size_type size_class = sizeClass(capacity);
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(nodes);
+        block->next = free_blocks[size_class];
+        free_blocks[size_class] = block;
+    }
+
+    [[nodiscard]] static Node *storage(Window &window) noexcept {
+        return window.nodes == nullptr ? window.inline_nodes : window.nodes;
+    }
+
+    [[nodiscard]] static const Node *storage(const Window &window) noexcept {
+        return window.nodes == nullptr ? window.inline_nodes : window.nodes;
+    }
+
+    [[nodiscard]] Window &getWindow(size_type key) {
+        if (key >= windows_count) {
+            throw std::out_of_range("Unknown window");
+        }
+        return windows[key];
+    }
+
+    [[nodiscard]] const Window &getWindow(size_type key) const {
+        if (key >= windows_count) {
+            throw std::out_of_range("Unknown window");
+        }
+        return windows[key];
+    }
+
+    void growWindow(Window &window) {
+        // Capacities are 32-bit, a doubled one mustn't wrap around
+        if (window.capacity > std::numeric_limits<std::uint32_t>::max() / 2) {
+            throw std::length_error("Window is too big");
+        }
+        std::uint32_t new_capacity = window.capacity * 2;
+        Node *new_nodes = allocateBlock(new_capacity);
+        Node *nodes = storage(window);
+        std::memcpy(new_nodes, nodes, sizeof(Node) * window.push_size);
+        std::memcpy(new_nodes + new_capacity - window.pop_size, nodes + window.capacity - window.pop_size,
+                    sizeof(Node) * window.pop_size);
+        if (window.nodes != nullptr) {
+            releaseBlock(window.nodes, window.capacity);
+        }
+        window.nodes = new_nodes;
+        window.capacity = new_capacity;
+    }
+
+    // Move push stack to the end of the block computing min/max from the newest element
+    static void flip(Window &window) noexcept {
+        Node *nodes = storage(window);
+        std::uint32_t push_size = window.push_size;
+        Node *pop_bottom = nodes + window.capacity - push_size;
+        value_type min_value = nodes[push_size - 1].self_value;
+        value_type max_value = min_value;
+        for (std::uint32_t i = push_size; i > 0; --i) {
+            value_type self_value = nodes[i - 1].self_value;
+            min_value = self_value < min_value ? self_value : min_value;
+            max_value = self_value > max_value ? self_value : max_value;
+            pop_bottom[i - 1] = Node{self_value, min_value, max_value};
+        }
+        window.pop_size = push_size;
+        window.push_size = 0;
+    }
+
+    void growWindows() {
+        size_type new_capacity = windows_capacity * 2 + 1;
+        Window *new_windows = static_cast<Window *>(::operator new(sizeof(Window) * new_capacity));
+        if (windows_count > 0) {
+            std::memcpy(new_windows, windows, sizeof(Window) * windows_count);
+        }
+        ::operator delete(windows);
+        windows = new_windows;
+        windows_capacity = new_capacity;
+    }
+
+public:
+    explicit BasicMinMaxQueueBank(size_type initial_windows = 0)
+        : windows(nullptr), windows_count(0), windows_capacity(0), chunks(Stack<char *>(16)), chunk_pointer(nullptr),
+          chunk_left(0), arena_bytes(0), free_blocks{} {
+        if (initial_windows > 0) {
+            windows = static_cast<Window *>(::operator new(sizeof(Window) * initial_windows));
+            windows_capacity = initial_windows;
+            while (windows_count < initial_windows) {
+                addWindow();
+            }
+        }
+    }
+
+    BasicMinMaxQueueBank(const BasicMinMaxQueueBank &other) = delete;
+
+    BasicMinMaxQueueBank &operator=(const BasicMinMaxQueueBank &other) = delete;
+
+    ~BasicMinMaxQueueBank() {
+        ::operator delete(windows);
+        while (!chunks.empty()) {
+            ::operator delete(chunks.top());
+            chunks.pop();
+        }
+    }
+
+    // Capacity
+    [[nodiscard]] size_type getWindowsCount() const noexcept { return windows_count; }
+
+    [[nodiscard]] bool empty(size_type key) const {
+        const Window &window = getWindow(key);
+        return window.push_size + window.pop_size == 0;
+    }
+
+    [[nodiscard]] size_type getSize(size_type key) const {
+        const Window &window = getWindow(key);
+        return window.push_size + window.pop_size;
+    }
+
+    // Bytes of window records and arena chunks
+    [[nodiscard]] size_type getReservedBytes() const noexcept {
+        return sizeof(Window) * windows_capacity + arena_bytes;
+    }
+
+    // Requests
+    // max - min in T like Queue<MinMaxNode>, wraps around if it doesn't fit
+    [[nodiscard]] value_type getMaxDiff(size_type key) const { return static_cast<value_type>(getMaxDiffExact(key)); }
+
+    [[nodiscard]] difference_type getMaxDiffExact(size_type key) const {
+        const Window &window = getWindow(key);
+        if (window.push_size + window.pop_size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        const Node *nodes = storage(window);
+        if (window.pop_size == 0) {
+            const Node &push_top = nodes[window.push_size - 1];
+            return minMaxDifference(push_top.min_value, push_top.max_value);
+        }
+        const Node &pop_top = nodes[window.capacity - window.pop_size];
+        if (window.push_size == 0) {
+            return minMaxDifference(pop_top.min_value, pop_top.max_value);
+        }
+        const Node &push_top = nodes[window.push_size - 1];
+        value_type max_value = push_top.max_value > pop_top.max_value ? push_top.max_value : pop_top.max_value;
+        value_type min_value = push_top.min_value < pop_top.min_value ? push_top.min_value : pop_top.min_value;
+        return minMaxDifference(min_value, max_value);
+    }
+
+    // Modifiers
+    // Return the key of the new empty window
+    size_type addWindow() {
+        if (windows_count == windows_capacity) {
+            growWindows();
+        }
+        Window &window = windows[windows_count];
+        window.nodes = nullptr;
+        window.capacity = kInlineCapacity;
+        window.push_size = 0;
+        window.pop_size = 0;
+        return windows_count++;
+    }
+
+    void pop(size_type key) {
+        Window &window = getWindow(key);
+        if (window.push_size + window.pop_size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (window.pop_size == 0) {
+            flip(window);
+        }
+        --window.pop_size;
+    }
+
+    void push(size_type key, value_type value) {
+        Window &window = getWindow(key);
+        if (window.push_size + window.pop_size == window.capacity) {
+            growWindow(window);
+        }
+        Node *nodes = storage(window);
+        Node node{value, value, value};
+        if (window.push_size > 0) {
+            const Node &top_node = nodes[window.push_size - 1];
+            node.min_value = top_node.min_value < value ? top_node.min_value : value;
+            node.max_value = top_node.max_value > value ? top_node.max_value : value;
+        }
+        nodes[window.push_size] = node;
+        ++window.push_size;
+    }
+};
+
+using MinMaxQueueBank = BasicMinMaxQueueBank<int>;
+
+#endif // MIN_MAX_QUEUE_BANK
@@ -0,0 +1,109 @@
+#ifndef MIN_MAX_QUEUE_BATCH_WINDOW
+#define MIN_MAX_QUEUE_BATCH_WINDOW
+#include "../MinMaxNode/MinMaxNode.h"
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// Offline sliding window min/max over a whole array (van Herk/Gil-Werman algorithm)
+// The input is split into blocks of window elements. For each position the running min/max from
+// the position to the end of its block (suffix) and from the start of its block to the position
+// (prefix) are computed, then the window [i, i + window) is the union of the suffix at i and the
+// prefix at i + window - 1. That is 3 comparisons per element for any window size, and the final
+// merge is an element-wise pass the compiler turns into SIMD min/max instructions.
+namespace batch_window {
+
+using size_type = std::size_t;
+
+template <typename T>
+inline T minValue(T left, T right) noexcept {
+    return right < left ? right : left;
+}
+
+template <typename T>
+inline T maxValue(T left, T right) noexcept {
+    return left < right ? right : left;
+}
+
+// Suffix min/max of the block [block_start, block_start + window), stored for output positions only
+template <typename T>
+void blockSuffix(const T *input, size_type size, size_type window, size_type block_start, T *min_output,
+                 T *max_output) noexcept {
+    size_type outputs = size - window + 1;
+    size_type i = (block_start + window < size ? block_start + window : size) - 1;
+    T running_min = input[i];
+    T running_max = input[i];
+    for (; i >= outputs; --i) {
+        running_min = minValue(running_min, input[i]);
+        running_max = maxValue(running_max, input[i]);
+    }
+    for (;; --i) {
+        running_min = minValue(running_min, input[i]);
+        running_max = maxValue(running_max, input[i]);
+        min_output[i] = running_min;
+        max_output[i] = running_max;
+        if (i == block_start) {
+            break;
+        }
+    }
+}
+
+// Prefix min/max of the first count elements of the block starting at block_start
+template <typename T>
+void blockPrefix(const T *input, size_type block_start, size_type count, T *min_prefix, T *max_prefix) noexcept {
+    T running_min = input[block_start];
+    T running_max = input[block_start];
+    for (size_type t = 0; t < count; ++t) {
+        running_min = minValue(running_min, input[block_start + t]);
+        running_max = maxValue(running_max, input[block_start + t]);
+        min_prefix[t] = running_min;
+        max_prefix[t] = running_max;
+    }
+}
+
+} // namespace batch_window
+
+// Write min and max of every window [i, i + window) for i in [0, size - window]
+// min_output and max_output must have room for size - window + 1 elements
+template <typename T>
+void slidingWindowMinMax(const T *input, std::size_t size, std::size_t window, T *min_output, T *max_output) {
+    static_assert(std::is_arithmetic_v<T>, "Batch window works with arithmetic types");
+    if (window == 0 || window > size) {
+        throw std::invalid_argument("Window size must be in [1, size]");
+    }
+    std::size_t outputs = size - window + 1;
+    // Prefixes of one block at a time, so the scratch stays in cache
+    T *min_prefix = static_cast<T *>(::operator new(sizeof(T) * window * 2));
+    T *max_prefix = min_prefix + window;
+    for (std::size_t block_start = 0; block_start < outputs; block_start += window) {
+        batch_window::blockSuffix(input, size, window, block_start, min_output, max_output);
+        // Window [i, i + window) for i in (block_start, block_start + window) is the suffix of this
+        // block at i and the prefix of the next block at i + window - 1
+        std::size_t next_block = block_start + window;
+        std::size_t count = next_block < size ? size - next_block : 0;
+        if (count > window - 1) {
+            count = window - 1;
+        }
+        batch_window::blockPrefix(input, next_block, count, min_prefix, max_prefix);
+        T *block_min_output = min_output + block_start + 1;
+        T *block_max_output = max_output + block_start + 1;
+        for (std::size_t t = 0; t < count; ++t) {
+            block_min_output[t] = batch_window::minValue(block_min_output[t], min_prefix[t]);
+            block_max_output[t] = batch_window::maxValue(block_max_output[t], max_prefix[t]);
+        }
+    }
+    ::operator delete(min_prefix);
+}
+
+// The same as slidingWindowMinMax and also the max difference (max - min) of every window
+template <typename T>
+void slidingWindowMaxDiff(const T *input, std::size_t size, std::size_t window, T *min_output, T *max_output,
+                          min_max_difference_t<T> *diff_output) {
+    slidingWindowMinMax(input, size, window, min_output, max_output);
+    std::size_t outputs = size - window + 1;
+    for (std::size_t i = 0; i < outputs; ++i) {
+        diff_output[i] = minMaxDifference(min_output[i], max_output[i]);
+    }
+}
+
+#endif // MIN_MAX_QUEUE_BATCH_WINDOW
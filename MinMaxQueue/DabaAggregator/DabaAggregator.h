@@ -0,0 +1,283 @@
+#ifndef MIN_MAX_QUEUE_DABA_AGGREGATOR
+#define MIN_MAX_QUEUE_DABA_AGGREGATOR
+#include "../Monoid/Monoid.h"
+#include <stdexcept>
+#include <type_traits>
+
+// De-amortized sliding window aggregator (DABA) on a ring buffer
+// Instead of moving the whole push stack at once, every push and pop does a constant amount of
+// the flip work, so push, pop and query are O(1) in the worst case while the size stays below
+// the reserved capacity (growth of the ring buffer itself is amortized).
+//
+// Elements are split by positions front <= left <= right <= accum <= back <= end into sublists
+// [front, left)  aggregate from the element to back - 1
+// [left, right)  aggregate from the element to right - 1 (front part before the flip)
+// [right, accum) aggregate from right to the element (back part before the flip)
+// [accum, back)  aggregate from the element to back - 1
+// [back, end)    aggregate from back to the element
+// A flip starts when the back part becomes longer than the front part and lasts for as many
+// operations as there are elements in [left, right), so [front, left) is never exhausted before
+// the flip ends.
+template <typename T, typename Monoid>
+class DabaAggregator {
+private:
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+
+    struct Node {
+        T value;
+        T aggregate;
+    };
+
+    Node *data;
+    // Always a power of two
+    size_type capacity;
+    size_type front_index;
+    size_type left_index;
+    size_type right_index;
+    size_type accum_index;
+    size_type back_index;
+    size_type end_index;
+    Monoid monoid;
+
+    [[nodiscard]] static size_type roundCapacity(size_type capacity) noexcept {
+        size_type rounded_capacity = 1;
+        while (rounded_capacity < capacity) {
+            rounded_capacity *= 2;
+        }
+        return rounded_capacity;
+    }
+
+    [[nodiscard]] Node &at(size_type position) noexcept { return data[position & (capacity - 1)]; }
+
+    [[nodiscard]] const Node &at(size_type position) const noexcept { return data[position & (capacity - 1)]; }
+
+    void swap(DabaAggregator<T, Monoid> &other) noexcept {
+        std::swap(data, other.data);
+        std::swap(capacity, other.capacity);
+        std::swap(front_index, other.front_index);
+        std::swap(left_index, other.left_index);
+        std::swap(right_index, other.right_index);
+        std::swap(accum_index, other.accum_index);
+        std::swap(back_index, other.back_index);
+        std::swap(end_index, other.end_index);
+        std::swap(monoid, other.monoid);
+    }
+
+    void free() noexcept {
+        if (!std::is_trivially_destructible_v<Node>) {
+            for (size_type position = front_index; position < end_index; ++position) {
+                at(position).~Node();
+            }
+        }
+        ::operator delete(data);
+    }
+
+    // Copy nodes of other to the beginning of new_data
+    static void uninitializedCopy(Node *new_data, const DabaAggregator<T, Monoid> &other) {
+        size_type copied_objects = 0;
+        try {
+            for (; copied_objects < other.end_index - other.front_index; ++copied_objects) {
+                new (new_data + copied_objects) Node(other.at(other.front_index + copied_objects));
+            }
+        } catch (...) {
+            if (!std::is_trivially_destructible_v<Node>) {
+                for (size_type j = 0; j < copied_objects; ++j) {
+                    (new_data + j)->~Node();
+                }
+            }
+            ::operator delete(new_data);
+            throw;
+        }
+    }
+
+    // Rebase positions so that the oldest element is at position 0
+    void rebase() noexcept {
+        left_index -= front_index;
+        right_index -= front_index;
+        accum_index -= front_index;
+        back_index -= front_index;
+        end_index -= front_index;
+        front_index = 0;
+    }
+
+    [[nodiscard]] T aggregateFront() const {
+        return front_index == back_index ? monoid.identity() : at(front_index).aggregate;
+    }
+
+    [[nodiscard]] T aggregateBack() const {
+        return back_index == end_index ? monoid.identity() : at(end_index - 1).aggregate;
+    }
+
+    [[nodiscard]] T aggregateLeft() const {
+        return left_index == right_index ? monoid.identity() : at(left_index).aggregate;
+    }
+
+    [[nodiscard]] T aggregateRight() const {
+        return right_index == accum_index ? monoid.identity() : at(accum_index - 1).aggregate;
+    }
+
+    [[nodiscard]] T aggregateAccum() const {
+        return accum_index == back_index ? monoid.identity() : at(accum_index).aggregate;
+    }
+
+    // One step of the incremental flip
+    void fixup() {
+        if (front_index == back_index) {
+            // The back part has at most one element, its prefix aggregate is a suffix aggregate too
+            left_index = end_index;
+            right_index = end_index;
+            accum_index = end_index;
+            back_index = end_index;
+            return;
+        }
+        if (left_index == back_index && end_index - back_index > back_index - front_index) {
+            left_index = front_index;
+            accum_index = end_index;
+            back_index = end_index;
+        }
+        if (left_index != back_index) {
+            T right_aggregate = monoid(aggregateRight(), aggregateAccum());
+            if (left_index != right_index) {
+                at(left_index).aggregate = monoid(aggregateLeft(), right_aggregate);
+                ++left_index;
+            }
+            if (right_index != accum_index) {
+                Node &node = at(accum_index - 1);
+                node.aggregate = monoid(node.value, aggregateAccum());
+                --accum_index;
+            }
+            if (left_index == right_index && right_index == accum_index) {
+                // [accum_index, back_index) satisfies the invariant of [front_index, left_index)
+                left_index = back_index;
+                right_index = back_index;
+                accum_index = back_index;
+            }
+        }
+    }
+
+    void grow() {
+        size_type new_capacity = capacity > 0 ? capacity * 2 : 1;
+        Node *new_data = reinterpret_cast<Node *>(::operator new(sizeof(Node) * new_capacity));
+        size_type size = end_index - front_index;
+        if (std::is_nothrow_move_constructible_v<Node>) {
+            for (size_type moved_objects = 0; moved_objects < size; ++moved_objects) {
+                Node &node = at(front_index + moved_objects);
+                new (new_data + moved_objects) Node(std::move(node));
+                if (!std::is_trivially_destructible_v<Node>) {
+                    node.~Node();
+                }
+            }
+            ::operator delete(data);
+        } else {
+            uninitializedCopy(new_data, *this);
+            free();
+        }
+        data = new_data;
+        capacity = new_capacity;
+        rebase();
+    }
+
+public:
+    explicit DabaAggregator(const size_type &capacity = 128, const Monoid &monoid = Monoid())
+        : data(reinterpret_cast<Node *>(::operator new(sizeof(Node) * roundCapacity(capacity)))),
+          capacity(roundCapacity(capacity)), front_index(0), left_index(0), right_index(0), accum_index(0),
+          back_index(0), end_index(0), monoid(monoid) {}
+
+    DabaAggregator(const DabaAggregator<T, Monoid> &other)
+        : data(reinterpret_cast<Node *>(::operator new(sizeof(Node) * other.capacity))), capacity(other.capacity),
+          front_index(other.front_index), left_index(other.left_index), right_index(other.right_index),
+          accum_index(other.accum_index), back_index(other.back_index), end_index(other.end_index),
+          monoid(other.monoid) {
+        uninitializedCopy(data, other);
+        rebase();
+    }
+
+    DabaAggregator &operator=(const DabaAggregator<T, Monoid> &other) {
+        if (this != &other) {
+            DabaAggregator<T, Monoid> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    DabaAggregator(DabaAggregator<T, Monoid> &&other) noexcept
+        : data(nullptr), capacity(0), front_index(0), left_index(0), right_index(0), accum_index(0), back_index(0),
+          end_index(0), monoid(other.monoid) {
+        swap(other);
+    }
+
+    DabaAggregator &operator=(DabaAggregator<T, Monoid> &&other) noexcept {
+        if (this != &other) {
+            free();
+            data = nullptr;
+            capacity = 0;
+            front_index = left_index = right_index = accum_index = back_index = end_index = 0;
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~DabaAggregator() { free(); }
+
+    // Element access
+    [[nodiscard]] const_reference front() const {
+        if (front_index == end_index) {
+            throw std::length_error("Empty queue");
+        }
+        return at(front_index).value;
+    }
+
+    [[nodiscard]] const_reference back() const {
+        if (front_index == end_index) {
+            throw std::length_error("Empty queue");
+        }
+        return at(end_index - 1).value;
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return front_index == end_index; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return end_index - front_index; }
+
+    [[nodiscard]] size_type getCapacity() const noexcept { return capacity; }
+
+    // Requests
+    // Aggregate of the whole window from the oldest to the newest element, identity if the window is empty
+    [[nodiscard]] T query() const { return monoid(aggregateFront(), aggregateBack()); }
+
+    // Modifiers
+    void pop() {
+        if (front_index == end_index) {
+            throw std::length_error("Empty queue");
+        }
+        if (!std::is_trivially_destructible_v<Node>) {
+            at(front_index).~Node();
+        }
+        ++front_index;
+        fixup();
+    }
+
+    void push(const T &value) {
+        if (end_index - front_index == capacity) {
+            grow();
+        }
+        if (back_index == end_index) {
+            new (&at(end_index)) Node{value, value};
+        } else {
+            new (&at(end_index)) Node{value, monoid(at(end_index - 1).aggregate, value)};
+        }
+        ++end_index;
+        fixup();
+    }
+
+    // Grow the ring buffer in advance so that pushes never reallocate
+    void reserve(size_type new_capacity) {
+        while (capacity < new_capacity) {
+            grow();
+        }
+    }
+};
+
+#endif // MIN_MAX_QUEUE_DABA_AGGREGATOR
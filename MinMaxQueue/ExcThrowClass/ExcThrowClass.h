@@ -1,54 +1,76 @@
 #ifndef MIN_MAX_QUEUE_EXCEPTION_THROWING_CLASS
 #define MIN_MAX_QUEUE_EXCEPTION_THROWING_CLASS
-#include <exception>
-#include <iostream>
+#include <stdexcept>
 
+// Class for exception safety tests: keeps a heap buffer, counts live objects and throws from
+// constructors on demand
+// By default every 20th construction throws, failOnConstruction(n) makes exactly the n-th next
+// construction throw instead
 class ExcThrowClass {
 private:
-    static unsigned int created_objects;
+    static constexpr int kDataSize = 10;
+
+    inline static unsigned int live_objects = 0;
+    inline static unsigned int constructions = 0;
+    inline static unsigned int throw_period = 20;
+    inline static unsigned int fail_countdown = 0;
+
     int *data;
 
-public:
-    ExcThrowClass() {
-        ++created_objects;
-        if (created_objects % 20 == 0) {
-            throw std::runtime_error("Exception in default constructor");
-        }
-        data = new int[10];
-        for (int i = 0; i < 10; ++i) {
-            data[i] = i;
+    // Called before anything is acquired, so a throwing constructor leaks nothing
+    static void countConstruction(const char *message) {
+        ++constructions;
+        if (fail_countdown != 0) {
+            if (--fail_countdown == 0) {
+                throw std::runtime_error(message);
+            }
+        } else if (throw_period != 0 && constructions % throw_period == 0) {
+            throw std::runtime_error(message);
         }
     }
 
-    ExcThrowClass(const ExcThrowClass &other) {
-        ++created_objects;
-        if (created_objects % 20 == 0) {
-            throw std::runtime_error("Exception in copy constructor");
+public:
+    explicit ExcThrowClass(int value = 0) : data(nullptr) {
+        countConstruction("Exception in default constructor");
+        data = new int[kDataSize];
+        for (int i = 0; i < kDataSize; ++i) {
+            data[i] = value + i;
         }
-        data = new int[10];
-        for (int i = 0; i < 10; ++i) {
-            data[i] = other.data[i];
+        ++live_objects;
+    }
+
+    ExcThrowClass(const ExcThrowClass &other) : data(nullptr) {
+        countConstruction("Exception in copy constructor");
+        if (other.data != nullptr) {
+            data = new int[kDataSize];
+            for (int i = 0; i < kDataSize; ++i) {
+                data[i] = other.data[i];
+            }
         }
+        ++live_objects;
     }
 
     ExcThrowClass &operator=(const ExcThrowClass &other) {
         if (this != &other) {
-            delete[] data;
-            data = new int[10];
-            for (int i = 0; i < 10; ++i) {
-                data[i] = i;
+            int *new_data = nullptr;
+            if (other.data != nullptr) {
+                new_data = new int[kDataSize];
+                for (int i = 0; i < kDataSize; ++i) {
+                    new_data[i] = other.data[i];
+                }
             }
+            delete[] data;
+            data = new_data;
         }
         return *this;
     }
 
     ExcThrowClass(ExcThrowClass &&other) noexcept : data(other.data) {
-        ++created_objects;
+        ++live_objects;
         other.data = nullptr;
     }
 
     ExcThrowClass &operator=(ExcThrowClass &&other) noexcept {
-        ++created_objects;
         if (this != &other) {
             delete[] data;
             data = other.data;
@@ -58,11 +80,25 @@ public:
     }
 
     ~ExcThrowClass() {
-        --created_objects;
+        --live_objects;
         delete[] data;
     }
-};
 
-unsigned int ExcThrowClass::created_objects = 0;
+    // Value passed to the constructor, -1 for a moved-from object
+    [[nodiscard]] int getValue() const noexcept { return data == nullptr ? -1 : data[0]; }
+
+    [[nodiscard]] static unsigned int getLiveObjects() noexcept { return live_objects; }
+
+    // 0 disables periodic throwing
+    static void setThrowPeriod(unsigned int period) noexcept {
+        throw_period = period;
+        constructions = 0;
+    }
+
+    // 0 cancels a pending failure
+    static void failOnConstruction(unsigned int construction) noexcept { fail_countdown = construction; }
+
+    [[nodiscard]] static bool failurePending() noexcept { return fail_countdown != 0; }
+};
 
 #endif // MIN_MAX_QUEUE_EXCEPTION_THROWING_CLASS
@@ -0,0 +1,265 @@
+#ifndef MIN_MAX_QUEUE_LOCK_FREE_STACK
+#define MIN_MAX_QUEUE_LOCK_FREE_STACK
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Lock-free stack (Treiber stack) for many threads, e.g. a free list or a pool of work items
+// Nodes come from a pool of capacity nodes allocated up front and are never freed while the stack
+// lives, so a node is addressed by its 32-bit index. The head is a 64-bit word of a tag and an
+// index, and every successful exchange increments the tag, so a head that was popped and pushed
+// back in between (ABA) doesn't match. Free nodes are kept in a second stack of the same kind.
+// When an exchange on the head fails, push and pop try to meet in a random slot of an elimination
+// array: a push publishes its node there for a short time and a pop may take it without touching
+// the head, so under contention opposite operations cancel out.
+template <typename T>
+class LockFreeStack {
+private:
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Popped values are moved out of the pool");
+
+    using size_type = std::size_t;
+
+    static constexpr size_type kCacheLine = 64;
+    static constexpr std::uint32_t kNull = UINT32_MAX;
+    // Spins of a published push before it is withdrawn
+    static constexpr int kEliminationSpins = 128;
+
+    struct Node {
+        // Written by the owner of the node, read by threads racing for it
+        std::atomic<std::uint32_t> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        [[nodiscard]] T *value() noexcept { return reinterpret_cast<T *>(storage); }
+    };
+
+    // Tag in the high half, index in the low half
+    struct alignas(kCacheLine) TaggedIndex {
+        std::atomic<std::uint64_t> word;
+    };
+
+    Node *nodes;
+    size_type capacity;
+    TaggedIndex head;
+    TaggedIndex free_head;
+    TaggedIndex *slots;
+    size_type slots_count;
+
+    [[nodiscard]] static std::uint64_t pack(std::uint32_t tag, std::uint32_t index) noexcept {
+        return (static_cast<std::uint64_t>(tag) << 32) | index;
+    }
+
+    [[nodiscard]] static std::uint32_t tagOf(std::uint64_t word) noexcept {
+        return static_cast<std::uint32_t>(word >> 32);
+    }
+
+    [[nodiscard]] static std::uint32_t indexOf(std::uint64_t word) noexcept {
+        return static_cast<std::uint32_t>(word);
+    }
+
+    // xorshift per thread, only spreads threads over the slots
+    [[nodiscard]] size_type randomSlot() const noexcept {
+        thread_local std::uint32_t state =
+            static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % slots_count;
+    }
+
+    // One attempt to push the node on top of list
+    [[nodiscard]] bool tryLink(TaggedIndex &list, std::uint32_t index) noexcept {
+        std::uint64_t old_word = list.word.load(std::memory_order_relaxed);
+        nodes[index].next.store(indexOf(old_word), std::memory_order_relaxed);
+        return list.word.compare_exchange_weak(old_word, pack(tagOf(old_word) + 1, index),
+                                               std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    // One attempt to pop the top node of list into index (kNull if list is empty), false if another
+    // thread won the race
+    [[nodiscard]] bool tryUnlink(TaggedIndex &list, std::uint32_t &index) noexcept {
+        std::uint64_t old_word = list.word.load(std::memory_order_acquire);
+        index = indexOf(old_word);
+        if (index == kNull) {
+            return true;
+        }
+        std::uint32_t next = nodes[index].next.load(std::memory_order_relaxed);
+        return list.word.compare_exchange_weak(old_word, pack(tagOf(old_word) + 1, next),
+                                               std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void link(TaggedIndex &list, std::uint32_t index) noexcept {
+        while (!tryLink(list, index)) {
+        }
+    }
+
+    [[nodiscard]] std::uint32_t unlink(TaggedIndex &list) noexcept {
+        std::uint32_t index = kNull;
+        while (!tryUnlink(list, index)) {
+        }
+        return index;
+    }
+
+    // Publishes the node in a slot, true if a pop took it before the push withdrew it
+    [[nodiscard]] bool eliminatePush(std::uint32_t index) noexcept {
+        if (slots_count == 0) {
+            return false;
+        }
+        std::atomic<std::uint64_t> &slot = slots[randomSlot()].word;
+        std::uint64_t empty = slot.load(std::memory_order_relaxed);
+        if (indexOf(empty) != kNull) {
+            return false;
+        }
+        std::uint64_t published = pack(tagOf(empty) + 1, index);
+        if (!slot.compare_exchange_strong(empty, published, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+        for (int spin = 0; spin < kEliminationSpins; ++spin) {
+            if (slot.load(std::memory_order_relaxed) != published) {
+                return true;
+            }
+        }
+        return !slot.compare_exchange_strong(published, pack(tagOf(published) + 1, kNull),
+                                             std::memory_order_relaxed, std::memory_order_relaxed);
+    }
+
+    // Takes a node published by a push, kNull if there is none
+    [[nodiscard]] std::uint32_t eliminatePop() noexcept {
+        if (slots_count == 0) {
+            return kNull;
+        }
+        std::atomic<std::uint64_t> &slot = slots[randomSlot()].word;
+        std::uint64_t published = slot.load(std::memory_order_relaxed);
+        if (indexOf(published) == kNull ||
+            !slot.compare_exchange_strong(published, pack(tagOf(published) + 1, kNull),
+                                          std::memory_order_acquire, std::memory_order_relaxed)) {
+            return kNull;
+        }
+        return indexOf(published);
+    }
+
+    void pushNode(std::uint32_t index) noexcept {
+        while (!tryLink(head, index)) {
+            if (eliminatePush(index)) {
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint32_t popNode() noexcept {
+        std::uint32_t index = kNull;
+        while (!tryUnlink(head, index)) {
+            index = eliminatePop();
+            if (index != kNull) {
+                return index;
+            }
+        }
+        return index;
+    }
+
+    void free() noexcept {
+        if (!std::is_trivially_destructible_v<T>) {
+            std::uint32_t index = indexOf(head.word.load(std::memory_order_relaxed));
+            while (index != kNull) {
+                nodes[index].value()->~T();
+                index = nodes[index].next.load(std::memory_order_relaxed);
+            }
+        }
+        ::operator delete(nodes, std::align_val_t(alignof(Node)));
+        ::operator delete(slots, std::align_val_t(alignof(TaggedIndex)));
+    }
+
+public:
+    // Every node is allocated here, push fails once capacity values are in the stack
+    explicit LockFreeStack(size_type capacity, size_type slots_count = 8)
+        : nodes(nullptr), capacity(capacity), head(), free_head(), slots(nullptr),
+          slots_count(slots_count) {
+        if (capacity >= kNull) {
+            throw std::length_error("Capacity doesn't fit into 32-bit indices");
+        }
+        nodes = static_cast<Node *>(::operator new(sizeof(Node) * capacity, std::align_val_t(alignof(Node))));
+        try {
+            slots = static_cast<TaggedIndex *>(
+                ::operator new(sizeof(TaggedIndex) * slots_count, std::align_val_t(alignof(TaggedIndex))));
+        } catch (...) {
+            ::operator delete(nodes, std::align_val_t(alignof(Node)));
+            throw;
+        }
+        for (size_type i = 0; i < slots_count; ++i) {
+            new (&slots[i].word) std::atomic<std::uint64_t>(pack(0, kNull));
+        }
+        for (size_type i = 0; i < capacity; ++i) {
+            std::uint32_t next = i + 1 < capacity ? static_cast<std::uint32_t>(i + 1) : kNull;
+            new (&nodes[i].next) std::atomic<std::uint32_t>(next);
+        }
+        head.word.store(pack(0, kNull), std::memory_order_relaxed);
+        free_head.word.store(pack(0, capacity > 0 ? 0 : kNull), std::memory_order_relaxed);
+    }
+
+    LockFreeStack(const LockFreeStack &other) = delete;
+
+    LockFreeStack &operator=(const LockFreeStack &other) = delete;
+
+    // No other thread may use the stack any more
+    ~LockFreeStack() { free(); }
+
+    // Capacity
+    // A snapshot, other threads may change it right away
+    [[nodiscard]] bool empty() const noexcept {
+        return indexOf(head.word.load(std::memory_order_acquire)) == kNull;
+    }
+
+    [[nodiscard]] size_type getCapacity() const noexcept { return capacity; }
+
+    // Modifiers
+    // false if all nodes are in use
+    template <typename... Args>
+    bool tryEmplace(Args &&...args) {
+        std::uint32_t index = unlink(free_head);
+        if (index == kNull) {
+            return false;
+        }
+        try {
+            new (nodes[index].storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            link(free_head, index);
+            throw;
+        }
+        pushNode(index);
+        return true;
+    }
+
+    bool tryPush(const T &value) { return tryEmplace(value); }
+
+    bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+
+    void push(const T &value) {
+        if (!tryEmplace(value)) {
+            throw std::length_error("Full stack");
+        }
+    }
+
+    void push(T &&value) {
+        if (!tryEmplace(std::move(value))) {
+            throw std::length_error("Full stack");
+        }
+    }
+
+    // Empty if the stack is empty
+    [[nodiscard]] std::optional<T> pop() noexcept {
+        std::uint32_t index = popNode();
+        if (index == kNull) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(*nodes[index].value()));
+        nodes[index].value()->~T();
+        link(free_head, index);
+        return value;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_LOCK_FREE_STACK
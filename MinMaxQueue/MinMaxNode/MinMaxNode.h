@@ -1,10 +1,48 @@
 #ifndef MIN_MAX_QUEUE_MIN_MAX_NODE
 #define MIN_MAX_QUEUE_MIN_MAX_NODE
+#include <type_traits>
 
-struct MinMaxNode {
-    int self_value;
-    int min_value;
-    int max_value;
+template <typename T>
+struct BasicMinMaxNode {
+    T self_value;
+    T min_value;
+    T max_value;
 };
 
+using MinMaxNode = BasicMinMaxNode<int>;
+
+// Type of max - min that can't overflow: max >= min, so the difference of integers always fits
+// into the unsigned type of the same width
+template <typename T, typename = void>
+struct MinMaxDifference {
+    using type = T;
+};
+
+template <typename T>
+struct MinMaxDifference<T, std::enable_if_t<std::is_integral_v<T>>> {
+    using type = std::make_unsigned_t<T>;
+};
+
+template <typename T>
+using min_max_difference_t = typename MinMaxDifference<T>::type;
+
+template <typename T>
+[[nodiscard]] inline min_max_difference_t<T> minMaxDifference(T min_value, T max_value) noexcept {
+    using difference_type = min_max_difference_t<T>;
+    if constexpr (std::is_integral_v<T>) {
+        // Unsigned subtraction is modular, so the result is exact
+        return static_cast<difference_type>(static_cast<difference_type>(max_value) -
+                                            static_cast<difference_type>(min_value));
+    } else {
+        return max_value - min_value;
+    }
+}
+
+// max - min as T, which getMaxDiff() returns for compatibility with Queue<MinMaxNode>: a
+// difference that doesn't fit into T wraps around, getMaxDiffExact() has it exactly
+template <typename T>
+[[nodiscard]] inline T minMaxDifferenceAsValue(T min_value, T max_value) noexcept {
+    return static_cast<T>(minMaxDifference(min_value, max_value));
+}
+
 #endif
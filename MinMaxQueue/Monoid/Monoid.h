@@ -0,0 +1,113 @@
+#ifndef MIN_MAX_QUEUE_MONOID
+#define MIN_MAX_QUEUE_MONOID
+#include <cstddef>
+#include <limits>
+#include <numeric>
+
+// A monoid is a class with an identity() element and an associative operator() combining two values.
+// The left argument of operator() is always the older part of the window, so non-commutative
+// operations are supported as well.
+
+template <typename T>
+class SumMonoid {
+public:
+    [[nodiscard]] T identity() const noexcept { return T(); }
+
+    [[nodiscard]] T operator()(const T &left, const T &right) const { return left + right; }
+};
+
+template <typename T>
+class MinMonoid {
+public:
+    [[nodiscard]] T identity() const noexcept {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::max();
+        }
+    }
+
+    [[nodiscard]] T operator()(const T &left, const T &right) const { return right < left ? right : left; }
+};
+
+template <typename T>
+class MaxMonoid {
+public:
+    [[nodiscard]] T identity() const noexcept {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return -std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::lowest();
+        }
+    }
+
+    [[nodiscard]] T operator()(const T &left, const T &right) const { return left < right ? right : left; }
+};
+
+template <typename T>
+class GcdMonoid {
+public:
+    [[nodiscard]] T identity() const noexcept { return T(); }
+
+    [[nodiscard]] T operator()(const T &left, const T &right) const { return std::gcd(left, right); }
+};
+
+template <typename T>
+struct MinMax {
+    T min_value;
+    T max_value;
+};
+
+// Element of a window is MinMax{value, value}
+template <typename T>
+class MinMaxMonoid {
+public:
+    [[nodiscard]] MinMax<T> identity() const noexcept {
+        return MinMax<T>{MinMonoid<T>().identity(), MaxMonoid<T>().identity()};
+    }
+
+    [[nodiscard]] MinMax<T> operator()(const MinMax<T> &left, const MinMax<T> &right) const {
+        return MinMax<T>{right.min_value < left.min_value ? right.min_value : left.min_value,
+                         left.max_value < right.max_value ? right.max_value : left.max_value};
+    }
+};
+
+template <typename T>
+struct IndexedValue {
+    T value;
+    std::size_t index;
+};
+
+// On equal values the most recent (right) element wins
+template <typename T>
+class ArgMaxMonoid {
+public:
+    [[nodiscard]] IndexedValue<T> identity() const noexcept {
+        return IndexedValue<T>{MaxMonoid<T>().identity(), std::numeric_limits<std::size_t>::max()};
+    }
+
+    [[nodiscard]] IndexedValue<T> operator()(const IndexedValue<T> &left, const IndexedValue<T> &right) const {
+        return right.value < left.value ? left : right;
+    }
+};
+
+template <std::size_t Buckets>
+struct Histogram {
+    std::size_t counts[Buckets];
+};
+
+template <std::size_t Buckets>
+class HistogramMonoid {
+public:
+    [[nodiscard]] Histogram<Buckets> identity() const noexcept { return Histogram<Buckets>{}; }
+
+    [[nodiscard]] Histogram<Buckets> operator()(const Histogram<Buckets> &left, const Histogram<Buckets> &right) const {
+        Histogram<Buckets> merged;
+        for (std::size_t i = 0; i < Buckets; ++i) {
+            merged.counts[i] = left.counts[i] + right.counts[i];
+        }
+        return merged;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_MONOID
@@ -0,0 +1,238 @@
+#ifndef MIN_MAX_QUEUE_MONOTONIC_QUEUE
+#define MIN_MAX_QUEUE_MONOTONIC_QUEUE
+#include "../MinMaxNode/MinMaxNode.h"
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Min/max queue on two monotonic deques
+// Only the elements that can still become the minimum (maximum) of the window are stored, usually
+// far fewer than the window size. The deques are ring buffers (as Queue<T, 0>) that keep values and
+// push timestamps in separate arrays.
+template <typename T>
+class MonotonicQueue {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "MonotonicQueue stores values in raw arrays");
+
+    using size_type = std::size_t;
+
+    // Ring buffer deque with power of two capacity
+    class CandidateDeque {
+    private:
+        T *values;
+        size_type *timestamps;
+        size_type capacity;
+        size_type head;
+        size_type size;
+
+        [[nodiscard]] size_type index(size_type offset) const noexcept { return (head + offset) & (capacity - 1); }
+
+        void copyFrom(const CandidateDeque &other) noexcept {
+            for (size_type i = 0; i < other.size; ++i) {
+                values[i] = other.values[other.index(i)];
+                timestamps[i] = other.timestamps[other.index(i)];
+            }
+        }
+
+        void resize() {
+            CandidateDeque resized(capacity > 0 ? capacity * 2 : 1);
+            resized.copyFrom(*this);
+            resized.size = size;
+            swap(resized);
+        }
+
+    public:
+        explicit CandidateDeque(size_type capacity)
+            : values(static_cast<T *>(::operator new(sizeof(T) * capacity))), timestamps(nullptr),
+              capacity(capacity), head(0), size(0) {
+            try {
+                timestamps = static_cast<size_type *>(::operator new(sizeof(size_type) * capacity));
+            } catch (...) {
+                ::operator delete(values);
+                throw;
+            }
+        }
+
+        CandidateDeque(const CandidateDeque &other) : CandidateDeque(other.capacity) {
+            copyFrom(other);
+            size = other.size;
+        }
+
+        CandidateDeque &operator=(const CandidateDeque &other) {
+            if (this != &other) {
+                CandidateDeque copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        CandidateDeque(CandidateDeque &&other) noexcept
+            : values(nullptr), timestamps(nullptr), capacity(0), head(0), size(0) {
+            swap(other);
+        }
+
+        CandidateDeque &operator=(CandidateDeque &&other) noexcept {
+            if (this != &other) {
+                CandidateDeque moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        ~CandidateDeque() {
+            ::operator delete(values);
+            ::operator delete(timestamps);
+        }
+
+        void swap(CandidateDeque &other) noexcept {
+            std::swap(values, other.values);
+            std::swap(timestamps, other.timestamps);
+            std::swap(capacity, other.capacity);
+            std::swap(head, other.head);
+            std::swap(size, other.size);
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size == 0; }
+
+        [[nodiscard]] size_type getSize() const noexcept { return size; }
+
+        [[nodiscard]] size_type getCapacity() const noexcept { return capacity; }
+
+        [[nodiscard]] T frontValue() const noexcept { return values[head]; }
+
+        [[nodiscard]] size_type frontTimestamp() const noexcept { return timestamps[head]; }
+
+        [[nodiscard]] T backValue() const noexcept { return values[index(size - 1)]; }
+
+        // Make room for one more element so that pushBack can't throw
+        void reserveBack() {
+            if (size == capacity) {
+                resize();
+            }
+        }
+
+        void pushBack(T value, size_type timestamp) noexcept {
+            size_type back_index = index(size);
+            values[back_index] = value;
+            timestamps[back_index] = timestamp;
+            ++size;
+        }
+
+        void popBack() noexcept { --size; }
+
+        void popFront() noexcept {
+            head = index(1);
+            --size;
+        }
+    };
+
+    CandidateDeque min_candidates;
+    CandidateDeque max_candidates;
+    // Timestamps of the next pushed and the next popped elements
+    size_type push_timestamp;
+    size_type pop_timestamp;
+
+    [[nodiscard]] static size_type roundCapacity(size_type capacity) noexcept {
+        size_type rounded_capacity = 1;
+        while (rounded_capacity < capacity) {
+            rounded_capacity *= 2;
+        }
+        return rounded_capacity;
+    }
+
+public:
+    explicit MonotonicQueue(const size_type &capacity = 16)
+        : min_candidates(roundCapacity(capacity)), max_candidates(roundCapacity(capacity)), push_timestamp(0),
+          pop_timestamp(0) {}
+
+    MonotonicQueue(const MonotonicQueue<T> &other) = default;
+
+    MonotonicQueue &operator=(const MonotonicQueue<T> &other) = default;
+
+    // The moved-from queue is left empty: the deques empty themselves, the timestamps are made equal
+    MonotonicQueue(MonotonicQueue<T> &&other) noexcept
+        : min_candidates(std::move(other.min_candidates)), max_candidates(std::move(other.max_candidates)),
+          push_timestamp(other.push_timestamp), pop_timestamp(other.pop_timestamp) {
+        other.push_timestamp = 0;
+        other.pop_timestamp = 0;
+    }
+
+    MonotonicQueue &operator=(MonotonicQueue<T> &&other) noexcept {
+        if (this != &other) {
+            min_candidates = std::move(other.min_candidates);
+            max_candidates = std::move(other.max_candidates);
+            push_timestamp = other.push_timestamp;
+            pop_timestamp = other.pop_timestamp;
+            other.push_timestamp = 0;
+            other.pop_timestamp = 0;
+        }
+        return *this;
+    }
+
+    ~MonotonicQueue() = default;
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return push_timestamp == pop_timestamp; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return push_timestamp - pop_timestamp; }
+
+    // Number of stored min and max candidates
+    [[nodiscard]] size_type getCandidatesCount() const noexcept {
+        return min_candidates.getSize() + max_candidates.getSize();
+    }
+
+    // Requests
+    [[nodiscard]] T getMin() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        return min_candidates.frontValue();
+    }
+
+    [[nodiscard]] T getMax() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        return max_candidates.frontValue();
+    }
+
+    // max - min in T like Queue<MinMaxNode>, wraps around if it doesn't fit
+    [[nodiscard]] T getMaxDiff() const { return static_cast<T>(getMaxDiffExact()); }
+
+    [[nodiscard]] min_max_difference_t<T> getMaxDiffExact() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        return minMaxDifference(min_candidates.frontValue(), max_candidates.frontValue());
+    }
+
+    // Modifiers
+    void pop() {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (min_candidates.frontTimestamp() == pop_timestamp) {
+            min_candidates.popFront();
+        }
+        if (max_candidates.frontTimestamp() == pop_timestamp) {
+            max_candidates.popFront();
+        }
+        ++pop_timestamp;
+    }
+
+    void push(T value) {
+        min_candidates.reserveBack();
+        max_candidates.reserveBack();
+        while (!min_candidates.empty() && !(min_candidates.backValue() < value)) {
+            min_candidates.popBack();
+        }
+        while (!max_candidates.empty() && !(value < max_candidates.backValue())) {
+            max_candidates.popBack();
+        }
+        min_candidates.pushBack(value, push_timestamp);
+        max_candidates.pushBack(value, push_timestamp);
+        ++push_timestamp;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_MONOTONIC_QUEUE
@@ -0,0 +1,268 @@
+#ifndef MIN_MAX_QUEUE_QUANTILE_QUEUE
+#define MIN_MAX_QUEUE_QUANTILE_QUEUE
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Sliding window order statistics: push, pop of the oldest element and quantile(q) in O(log n)
+// Elements are nodes of a treap ordered by (value, push order) with subtree sizes. Nodes are
+// stored in a ring buffer in push order, so the oldest node is always at head and no extra FIFO
+// is needed for eviction.
+template <typename T>
+class QuantileQueue {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "QuantileQueue stores values in a raw ring buffer");
+
+    using size_type = std::size_t;
+
+    static constexpr size_type kNil = std::numeric_limits<size_type>::max();
+
+    struct Node {
+        T value;
+        size_type sequence;
+        size_type left;
+        size_type right;
+        size_type count;
+        std::uint32_t priority;
+    };
+
+    Node *nodes;
+    // Always a power of two
+    size_type capacity;
+    size_type head;
+    size_type size;
+    size_type root;
+    size_type next_sequence;
+    std::uint64_t random_state;
+
+    [[nodiscard]] static size_type roundCapacity(size_type capacity) noexcept {
+        size_type rounded_capacity = 1;
+        while (rounded_capacity < capacity) {
+            rounded_capacity *= 2;
+        }
+        return rounded_capacity;
+    }
+
+    [[nodiscard]] std::uint32_t nextPriority() noexcept {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return static_cast<std::uint32_t>(random_state >> 32);
+    }
+
+    [[nodiscard]] size_type count(size_type node) const noexcept { return node == kNil ? 0 : nodes[node].count; }
+
+    void update(size_type node) noexcept {
+        nodes[node].count = 1 + count(nodes[node].left) + count(nodes[node].right);
+    }
+
+    [[nodiscard]] bool less(size_type left, size_type right) const noexcept {
+        const Node &left_node = nodes[left];
+        const Node &right_node = nodes[right];
+        if (left_node.value < right_node.value) {
+            return true;
+        }
+        if (right_node.value < left_node.value) {
+            return false;
+        }
+        return left_node.sequence < right_node.sequence;
+    }
+
+    [[nodiscard]] size_type insert(size_type subtree, size_type node) noexcept {
+        if (subtree == kNil) {
+            return node;
+        }
+        if (less(node, subtree)) {
+            size_type child = insert(nodes[subtree].left, node);
+            nodes[subtree].left = child;
+            if (nodes[child].priority > nodes[subtree].priority) {
+                nodes[subtree].left = nodes[child].right;
+                update(subtree);
+                nodes[child].right = subtree;
+                update(child);
+                return child;
+            }
+        } else {
+            size_type child = insert(nodes[subtree].right, node);
+            nodes[subtree].right = child;
+            if (nodes[child].priority > nodes[subtree].priority) {
+                nodes[subtree].right = nodes[child].left;
+                update(subtree);
+                nodes[child].left = subtree;
+                update(child);
+                return child;
+            }
+        }
+        update(subtree);
+        return subtree;
+    }
+
+    // All elements of left are less than all elements of right
+    [[nodiscard]] size_type merge(size_type left, size_type right) noexcept {
+        if (left == kNil) {
+            return right;
+        }
+        if (right == kNil) {
+            return left;
+        }
+        if (nodes[left].priority > nodes[right].priority) {
+            nodes[left].right = merge(nodes[left].right, right);
+            update(left);
+            return left;
+        }
+        nodes[right].left = merge(left, nodes[right].left);
+        update(right);
+        return right;
+    }
+
+    [[nodiscard]] size_type erase(size_type subtree, size_type node) noexcept {
+        if (subtree == node) {
+            return merge(nodes[node].left, nodes[node].right);
+        }
+        if (less(node, subtree)) {
+            nodes[subtree].left = erase(nodes[subtree].left, node);
+        } else {
+            nodes[subtree].right = erase(nodes[subtree].right, node);
+        }
+        update(subtree);
+        return subtree;
+    }
+
+    [[nodiscard]] size_type rebased(size_type node) const noexcept {
+        return node == kNil ? kNil : (node - head) & (capacity - 1);
+    }
+
+    void resize() {
+        size_type new_capacity = capacity > 0 ? capacity * 2 : 1;
+        Node *new_nodes = static_cast<Node *>(::operator new(sizeof(Node) * new_capacity));
+        for (size_type i = 0; i < size; ++i) {
+            Node node = nodes[(head + i) & (capacity - 1)];
+            node.left = rebased(node.left);
+            node.right = rebased(node.right);
+            new_nodes[i] = node;
+        }
+        root = rebased(root);
+        ::operator delete(nodes);
+        nodes = new_nodes;
+        capacity = new_capacity;
+        head = 0;
+    }
+
+public:
+    explicit QuantileQueue(const size_type &capacity = 128)
+        : nodes(static_cast<Node *>(::operator new(sizeof(Node) * roundCapacity(capacity)))),
+          capacity(roundCapacity(capacity)), head(0), size(0), root(kNil), next_sequence(0),
+          random_state(0x9E3779B97F4A7C15ULL) {}
+
+    QuantileQueue(const QuantileQueue<T> &other)
+        : nodes(static_cast<Node *>(::operator new(sizeof(Node) * other.capacity))), capacity(other.capacity),
+          head(other.head), size(other.size), root(other.root), next_sequence(other.next_sequence),
+          random_state(other.random_state) {
+        for (size_type i = 0; i < size; ++i) {
+            size_type index = (head + i) & (capacity - 1);
+            nodes[index] = other.nodes[index];
+        }
+    }
+
+    QuantileQueue &operator=(const QuantileQueue<T> &other) {
+        if (this != &other) {
+            QuantileQueue<T> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    QuantileQueue(QuantileQueue<T> &&other) noexcept
+        : nodes(nullptr), capacity(0), head(0), size(0), root(kNil), next_sequence(0),
+          random_state(0x9E3779B97F4A7C15ULL) {
+        swap(other);
+    }
+
+    QuantileQueue &operator=(QuantileQueue<T> &&other) noexcept {
+        if (this != &other) {
+            QuantileQueue<T> moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~QuantileQueue() { ::operator delete(nodes); }
+
+    void swap(QuantileQueue<T> &other) noexcept {
+        std::swap(nodes, other.nodes);
+        std::swap(capacity, other.capacity);
+        std::swap(head, other.head);
+        std::swap(size, other.size);
+        std::swap(root, other.root);
+        std::swap(next_sequence, other.next_sequence);
+        std::swap(random_state, other.random_state);
+    }
+
+    // Element access
+    [[nodiscard]] T front() const {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        return nodes[head].value;
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return size == 0; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return size; }
+
+    // Requests
+    // k-th smallest element of the window, k starts from 0
+    [[nodiscard]] T getKth(size_type k) const {
+        if (k >= size) {
+            throw std::out_of_range("Order statistic out of range");
+        }
+        size_type node = root;
+        while (true) {
+            size_type left_count = count(nodes[node].left);
+            if (k < left_count) {
+                node = nodes[node].left;
+            } else if (k == left_count) {
+                return nodes[node].value;
+            } else {
+                k -= left_count + 1;
+                node = nodes[node].right;
+            }
+        }
+    }
+
+    // Element of rank floor(q * (size - 1)) for q in [0, 1], getQuantile(0.5) is the (lower) median
+    [[nodiscard]] T getQuantile(double q) const {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("Quantile must be in [0, 1]");
+        }
+        return getKth(static_cast<size_type>(q * static_cast<double>(size - 1)));
+    }
+
+    // Modifiers
+    void pop() {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        root = erase(root, head);
+        head = (head + 1) & (capacity - 1);
+        --size;
+    }
+
+    void push(const T &value) {
+        if (size == capacity) {
+            resize();
+        }
+        size_type node = (head + size) & (capacity - 1);
+        nodes[node] = Node{value, next_sequence, kNil, kNil, 1, nextPriority()};
+        ++next_sequence;
+        root = insert(root, node);
+        ++size;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_QUANTILE_QUEUE
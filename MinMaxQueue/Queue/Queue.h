@@ -15,16 +15,30 @@ private:
     Stack<T> pop_stack;
 
 public:
-    explicit Queue(const size_type &capacity)
-        : size(0), push_stack(Stack<T>(capacity)), pop_stack(Stack<T>(capacity)) {}
+    // Stacks allocate on their first push, so an empty queue allocates nothing
+    explicit Queue(const size_type &capacity,
+                   std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+        : size(0), push_stack(Stack<T>(capacity, resource)), pop_stack(Stack<T>(capacity, resource)) {}
 
     Queue(const Queue<T> &other) = default;
 
     Queue &operator=(const Queue<T> &other) = default;
 
-    Queue(Queue<T> &&other) noexcept = default;
+    // The moved-from queue is left empty: the stacks empty themselves, size has to be reset too
+    Queue(Queue<T> &&other) noexcept
+        : size(other.size), push_stack(std::move(other.push_stack)), pop_stack(std::move(other.pop_stack)) {
+        other.size = 0;
+    }
 
-    Queue &operator=(Queue<T> &&other) noexcept = default;
+    Queue &operator=(Queue<T> &&other) noexcept {
+        if (this != &other) {
+            size = other.size;
+            push_stack = std::move(other.push_stack);
+            pop_stack = std::move(other.pop_stack);
+            other.size = 0;
+        }
+        return *this;
+    }
 
     ~Queue() = default;
 
@@ -34,9 +48,9 @@ public:
             throw std::length_error("Empty queue");
         }
         if (pop_stack.empty()) {
-            return push_stack.bottom();
+            return push_stack.bottomUnchecked();
         }
-        return pop_stack.top();
+        return pop_stack.topUnchecked();
     }
 
     [[nodiscard]] const_reference front() const {
@@ -44,9 +58,9 @@ public:
             throw std::length_error("Empty queue");
         }
         if (pop_stack.empty()) {
-            return push_stack.bottom();
+            return push_stack.bottomUnchecked();
         }
-        return pop_stack.top();
+        return pop_stack.topUnchecked();
     }
 
     [[nodiscard]] reference back() {
@@ -54,9 +68,9 @@ public:
             throw std::length_error("Empty queue");
         }
         if (!push_stack.empty()) {
-            return push_stack.top();
+            return push_stack.topUnchecked();
         }
-        return pop_stack.bottom();
+        return pop_stack.bottomUnchecked();
     }
 
     [[nodiscard]] const_reference back() const {
@@ -64,9 +78,9 @@ public:
             throw std::length_error("Empty queue");
         }
         if (!push_stack.empty()) {
-            return push_stack.top();
+            return push_stack.topUnchecked();
         }
-        return pop_stack.bottom();
+        return pop_stack.bottomUnchecked();
     }
 
     // Capacity
@@ -74,6 +88,13 @@ public:
 
     [[nodiscard]] std::size_t getSize() const noexcept { return size; }
 
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        MemoryUsage usage = push_stack.memoryUsage();
+        usage += pop_stack.memoryUsage();
+        usage.overhead_bytes += sizeof(*this) - sizeof(push_stack) - sizeof(pop_stack);
+        return usage;
+    }
+
     // Modifiers
     void pop() {
         if (size == 0) {
@@ -82,7 +103,7 @@ public:
         if (pop_stack.empty()) {
             Stack<T>::template MoveStackContent<T>::get(pop_stack, push_stack);
         }
-        pop_stack.pop();
+        pop_stack.popUnchecked();
         --size;
     }
 
@@ -92,65 +113,76 @@ public:
     }
 
     void push(T &&value) {
-        push_stack.push(value);
+        push_stack.push(std::move(value));
         ++size;
     }
 };
 
-template <>
-class Queue<MinMaxNode> {
+// Min/max queue for any arithmetic type, Queue<MinMaxNode> is Queue<BasicMinMaxNode<int>>
+// push_stack keeps only values and the min and max of all of them, min and max of every element
+// are computed only when it is moved to pop_stack
+template <typename T>
+class Queue<BasicMinMaxNode<T>> {
 private:
-    using reference = MinMaxNode &;
-    using const_reference = const MinMaxNode &;
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Min/max queue needs an arithmetic type");
+
+    using value_type = T;
+    using const_reference = const T &;
     using size_type = std::size_t;
+    using difference_type = min_max_difference_t<T>;
 
     size_type size;
-    Stack<MinMaxNode> push_stack;
-    Stack<MinMaxNode> pop_stack;
+    Stack<T> push_stack;
+    Stack<BasicMinMaxNode<T>> pop_stack;
+    // Valid only if push_stack is not empty
+    T push_min;
+    T push_max;
 
 public:
-    explicit Queue(const size_type &capacity)
-        : size(0), push_stack(Stack<MinMaxNode>(capacity)), pop_stack(Stack<MinMaxNode>(capacity)) {}
-
-    Queue(const Queue<MinMaxNode> &other) = default;
-
-    Queue &operator=(const Queue<MinMaxNode> &other) = default;
-
-    Queue(Queue<MinMaxNode> &&other) noexcept = default;
+    // Stacks allocate on their first push, so an empty queue allocates nothing
+    explicit Queue(const size_type &capacity,
+                   std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+        : size(0), push_stack(Stack<T>(capacity, resource)),
+          pop_stack(Stack<BasicMinMaxNode<T>>(capacity, resource)), push_min(), push_max() {}
+
+    Queue(const Queue<BasicMinMaxNode<T>> &other) = default;
+
+    Queue &operator=(const Queue<BasicMinMaxNode<T>> &other) = default;
+
+    // The moved-from queue is left empty: the stacks empty themselves, size has to be reset too
+    Queue(Queue<BasicMinMaxNode<T>> &&other) noexcept
+        : size(other.size), push_stack(std::move(other.push_stack)), pop_stack(std::move(other.pop_stack)),
+          push_min(other.push_min), push_max(other.push_max) {
+        other.size = 0;
+        other.push_min = T();
+        other.push_max = T();
+    }
 
-    Queue &operator=(Queue<MinMaxNode> &&other) noexcept = default;
+    Queue &operator=(Queue<BasicMinMaxNode<T>> &&other) noexcept {
+        if (this != &other) {
+            size = other.size;
+            push_stack = std::move(other.push_stack);
+            pop_stack = std::move(other.pop_stack);
+            push_min = other.push_min;
+            push_max = other.push_max;
+            other.size = 0;
+            other.push_min = T();
+            other.push_max = T();
+        }
+        return *this;
+    }
 
     ~Queue() = default;
 
     // Element access
-    [[nodiscard]] reference front() {
-        if (size == 0) {
-            throw std::length_error("Empty queue");
-        }
-        if (pop_stack.empty()) {
-            return push_stack.bottom();
-        }
-        return pop_stack.top();
-    }
-
     [[nodiscard]] const_reference front() const {
         if (size == 0) {
             throw std::length_error("Empty queue");
         }
         if (pop_stack.empty()) {
-            return push_stack.bottom();
+            return push_stack.bottomUnchecked();
         }
-        return pop_stack.top();
-    }
-
-    [[nodiscard]] reference back() {
-        if (size == 0) {
-            throw std::length_error("Empty queue");
-        }
-        if (!push_stack.empty()) {
-            return push_stack.top();
-        }
-        return pop_stack.bottom();
+        return pop_stack.topUnchecked().self_value;
     }
 
     [[nodiscard]] const_reference back() const {
@@ -158,9 +190,9 @@ public:
             throw std::length_error("Empty queue");
         }
         if (!push_stack.empty()) {
-            return push_stack.top();
+            return push_stack.topUnchecked();
         }
-        return pop_stack.bottom();
+        return pop_stack.bottomUnchecked().self_value;
     }
 
     // Capacity
@@ -168,53 +200,77 @@ public:
 
     [[nodiscard]] std::size_t getSize() const noexcept { return size; }
 
+    // The min and max kept in every pop_stack node are overhead, only the values are live
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        MemoryUsage usage = push_stack.memoryUsage();
+        MemoryUsage nodes = pop_stack.memoryUsage();
+        std::size_t bookkeeping = (sizeof(BasicMinMaxNode<T>) - sizeof(T)) * pop_stack.getSize();
+        nodes.live_bytes -= bookkeeping;
+        nodes.overhead_bytes += bookkeeping;
+        usage += nodes;
+        usage.overhead_bytes += sizeof(*this) - sizeof(push_stack) - sizeof(pop_stack);
+        return usage;
+    }
+
     // Requests
-    [[nodiscard]] int getMaxDiff() const {
+    [[nodiscard]] value_type getMin() const {
         if (size == 0) {
             throw std::length_error("Empty queue");
         }
         if (push_stack.empty()) {
-            const MinMaxNode &pop_stack_top = pop_stack.top();
-            return pop_stack_top.max_value - pop_stack_top.min_value;
+            return pop_stack.topUnchecked().min_value;
         }
         if (pop_stack.empty()) {
-            const MinMaxNode &push_stack_top = push_stack.top();
-            return push_stack_top.max_value - push_stack_top.min_value;
+            return push_min;
         }
-        const MinMaxNode &pop_stack_top = pop_stack.top();
-        const MinMaxNode &push_stack_top = push_stack.top();
-        int max_value =
-            push_stack_top.max_value > pop_stack_top.max_value ? push_stack_top.max_value : pop_stack_top.max_value;
-        int min_value =
-            push_stack_top.min_value < pop_stack_top.min_value ? push_stack_top.min_value : pop_stack_top.min_value;
-        return max_value - min_value;
+        const value_type &pop_min = pop_stack.topUnchecked().min_value;
+        return push_min < pop_min ? push_min : pop_min;
     }
 
+    [[nodiscard]] value_type getMax() const {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_stack.empty()) {
+            return pop_stack.topUnchecked().max_value;
+        }
+        if (pop_stack.empty()) {
+            return push_max;
+        }
+        const value_type &pop_max = pop_stack.topUnchecked().max_value;
+        return push_max > pop_max ? push_max : pop_max;
+    }
+
+    // max - min in T, as Queue<MinMaxNode> always returned it, wraps around if it doesn't fit
+    [[nodiscard]] value_type getMaxDiff() const { return minMaxDifferenceAsValue(getMin(), getMax()); }
+
+    // max - min that never overflows, unsigned for integers
+    [[nodiscard]] difference_type getMaxDiffExact() const { return minMaxDifference(getMin(), getMax()); }
+
     // Modifiers
     void pop() {
         if (size == 0) {
             throw std::length_error("Empty queue");
         }
         if (pop_stack.empty()) {
-            Stack<MinMaxNode>::template MoveStackContent<MinMaxNode>::get(pop_stack, push_stack);
+            MoveMinMaxContent<T>::get(pop_stack, push_stack);
         }
-        pop_stack.pop();
+        pop_stack.popUnchecked();
         --size;
     }
 
-    void push(int value) {
-        if (push_stack.empty()) {
-            push_stack.push(MinMaxNode{value, value, value});
+    void push(value_type value) {
+        push_stack.push(value);
+        if (push_stack.getSize() == 1) {
+            push_min = value;
+            push_max = value;
         } else {
-            MinMaxNode &&node_to_push = {value, value, value};
-            const MinMaxNode &top_node = push_stack.top();
-            if (top_node.min_value < node_to_push.min_value) {
-                node_to_push.min_value = top_node.min_value;
+            if (value < push_min) {
+                push_min = value;
             }
-            if (top_node.max_value > node_to_push.max_value) {
-                node_to_push.max_value = top_node.max_value;
+            if (value > push_max) {
+                push_max = value;
             }
-            push_stack.push(node_to_push);
         }
         ++size;
     }
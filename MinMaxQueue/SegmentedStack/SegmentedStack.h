@@ -0,0 +1,244 @@
+#ifndef MIN_MAX_QUEUE_SEGMENTED_STACK
+#define MIN_MAX_QUEUE_SEGMENTED_STACK
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Stack on a chain of fixed-size chunks
+// Growth allocates one more chunk and never moves elements, so push and pop are O(1) in the
+// worst case and references to elements stay valid until they are popped
+// The last emptied chunk is kept as a spare, so pushes and pops around a chunk boundary don't
+// allocate and free a chunk every time
+template <typename T, std::size_t ChunkCapacity = (4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1)>
+class SegmentedStack {
+private:
+    static_assert(ChunkCapacity > 0, "Chunk must keep at least one element");
+
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+
+    struct Chunk {
+        Chunk *previous;
+        alignas(T) unsigned char storage[sizeof(T) * ChunkCapacity];
+
+        [[nodiscard]] T *data() noexcept { return reinterpret_cast<T *>(storage); }
+
+        [[nodiscard]] const T *data() const noexcept { return reinterpret_cast<const T *>(storage); }
+    };
+
+    Chunk *top_chunk;
+    Chunk *bottom_chunk;
+    Chunk *spare_chunk;
+    // Elements in top_chunk, all chunks below it are full
+    size_type top_count;
+    size_type size;
+
+    void swap(SegmentedStack &other) noexcept {
+        std::swap(top_chunk, other.top_chunk);
+        std::swap(bottom_chunk, other.bottom_chunk);
+        std::swap(spare_chunk, other.spare_chunk);
+        std::swap(top_count, other.top_count);
+        std::swap(size, other.size);
+    }
+
+    // Chunks of an over-aligned T are over-aligned too, and plain operator new wouldn't respect that
+    [[nodiscard]] static Chunk *allocateChunk() {
+        if constexpr (alignof(Chunk) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<Chunk *>(::operator new(sizeof(Chunk), std::align_val_t{alignof(Chunk)}));
+        } else {
+            return static_cast<Chunk *>(::operator new(sizeof(Chunk)));
+        }
+    }
+
+    static void deallocateChunk(Chunk *chunk) noexcept {
+        if constexpr (alignof(Chunk) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(chunk, std::align_val_t{alignof(Chunk)});
+        } else {
+            ::operator delete(chunk);
+        }
+    }
+
+    void free() noexcept {
+        size_type count = top_count;
+        while (top_chunk != nullptr) {
+            if (!std::is_trivially_destructible_v<T>) {
+                for (size_type i = 0; i < count; ++i) {
+                    (top_chunk->data() + i)->~T();
+                }
+            }
+            Chunk *previous = top_chunk->previous;
+            deallocateChunk(top_chunk);
+            top_chunk = previous;
+            count = ChunkCapacity;
+        }
+        deallocateChunk(spare_chunk);
+        bottom_chunk = nullptr;
+        spare_chunk = nullptr;
+        top_count = 0;
+        size = 0;
+    }
+
+    // Makes room for one more element on top
+    void addChunk() {
+        Chunk *chunk = spare_chunk;
+        if (chunk == nullptr) {
+            chunk = allocateChunk();
+        }
+        spare_chunk = nullptr;
+        chunk->previous = top_chunk;
+        if (top_chunk == nullptr) {
+            bottom_chunk = chunk;
+        }
+        top_chunk = chunk;
+        top_count = 0;
+    }
+
+    void removeChunk() noexcept {
+        Chunk *chunk = top_chunk;
+        top_chunk = chunk->previous;
+        top_count = top_chunk == nullptr ? 0 : ChunkCapacity;
+        if (top_chunk == nullptr) {
+            bottom_chunk = nullptr;
+        }
+        deallocateChunk(spare_chunk);
+        spare_chunk = chunk;
+    }
+
+public:
+    SegmentedStack() noexcept
+        : top_chunk(nullptr), bottom_chunk(nullptr), spare_chunk(nullptr), top_count(0), size(0) {}
+
+    SegmentedStack(const SegmentedStack &other) : SegmentedStack() {
+        if (other.size == 0) {
+            return;
+        }
+        // Chunks are linked from top to bottom, so they are collected bottom first
+        size_type chunks_count = (other.size + ChunkCapacity - 1) / ChunkCapacity;
+        const Chunk **chunks = static_cast<const Chunk **>(::operator new(sizeof(Chunk *) * chunks_count));
+        const Chunk *chunk = other.top_chunk;
+        for (size_type i = chunks_count; i > 0; --i) {
+            chunks[i - 1] = chunk;
+            chunk = chunk->previous;
+        }
+        try {
+            for (size_type i = 0; i < chunks_count; ++i) {
+                size_type count = i + 1 == chunks_count ? other.top_count : ChunkCapacity;
+                for (size_type j = 0; j < count; ++j) {
+                    push(chunks[i]->data()[j]);
+                }
+            }
+        } catch (...) {
+            // The destructor frees the pushed elements
+            ::operator delete(chunks);
+            throw;
+        }
+        ::operator delete(chunks);
+    }
+
+    SegmentedStack &operator=(const SegmentedStack &other) {
+        if (this != &other) {
+            SegmentedStack copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedStack(SegmentedStack &&other) noexcept : SegmentedStack() { swap(other); }
+
+    SegmentedStack &operator=(SegmentedStack &&other) noexcept {
+        if (this != &other) {
+            free();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~SegmentedStack() { free(); }
+
+    // Element access
+    [[nodiscard]] reference top() {
+        if (size == 0) {
+            throw std::length_error("Empty stack");
+        }
+        return top_chunk->data()[top_count - 1];
+    }
+
+    [[nodiscard]] const_reference top() const {
+        if (size == 0) {
+            throw std::length_error("Empty stack");
+        }
+        return top_chunk->data()[top_count - 1];
+    }
+
+    [[nodiscard]] reference bottom() {
+        if (size == 0) {
+            throw std::length_error("Empty stack");
+        }
+        return bottom_chunk->data()[0];
+    }
+
+    [[nodiscard]] const_reference bottom() const {
+        if (size == 0) {
+            throw std::length_error("Empty stack");
+        }
+        return bottom_chunk->data()[0];
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return size == 0; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return size; }
+
+    // Modifiers
+    void pop() {
+        if (size == 0) {
+            throw std::length_error("Empty stack");
+        }
+        if (!std::is_trivially_destructible_v<T>) {
+            (top_chunk->data() + top_count - 1)->~T();
+        }
+        --top_count;
+        --size;
+        if (top_count == 0) {
+            removeChunk();
+        }
+    }
+
+    void push(const T &value) {
+        if (top_count == ChunkCapacity || top_chunk == nullptr) {
+            // Elements never move, so value stays valid even if it is an element of this stack
+            addChunk();
+            try {
+                new (top_chunk->data()) T(value);
+            } catch (...) {
+                removeChunk();
+                throw;
+            }
+        } else {
+            new (top_chunk->data() + top_count) T(value);
+        }
+        ++top_count;
+        ++size;
+    }
+
+    void push(T &&value) {
+        if (top_count == ChunkCapacity || top_chunk == nullptr) {
+            addChunk();
+            try {
+                new (top_chunk->data()) T(std::move(value));
+            } catch (...) {
+                removeChunk();
+                throw;
+            }
+        } else {
+            new (top_chunk->data() + top_count) T(std::move(value));
+        }
+        ++top_count;
+        ++size;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_SEGMENTED_STACK
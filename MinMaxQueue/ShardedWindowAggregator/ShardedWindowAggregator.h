@@ -0,0 +1,116 @@
+#ifndef MIN_MAX_QUEUE_SHARDED_WINDOW_AGGREGATOR
+#define MIN_MAX_QUEUE_SHARDED_WINDOW_AGGREGATOR
+#include "../TimeWindowAggregator/TimeWindowAggregator.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+
+// Time window shared by many producer threads
+// Every thread pushes to its own shard (a TimeWindowAggregator with its own mutex on its own cache
+// lines), so pushes from different threads don't contend with each other. This is not lock-free:
+// push() takes its shard's mutex, and query() and evictBefore() take every shard's mutex in turn, so
+// a reader blocks each producer while it visits that producer's shard, and both are O(shards).
+// Shards are combined in shard order, so the monoid should be commutative (min, max, sum).
+// If there are more threads than shards, threads share shards round-robin. A sample older than the
+// newest one of its shard is re-stamped to that newest timestamp, so it stays in the window past its
+// real expiry, until the newest timestamp of the shard expires.
+template <typename T, typename Monoid, typename Timestamp = std::int64_t>
+class ShardedWindowAggregator {
+private:
+    using size_type = std::size_t;
+
+    static constexpr size_type kCacheLine = 64;
+
+    struct alignas(kCacheLine) Shard {
+        std::mutex mutex;
+        TimeWindowAggregator<T, Monoid, Timestamp> window;
+        Timestamp newest_timestamp;
+        bool has_timestamp;
+
+        Shard(const Timestamp &bucket_width, const size_type &capacity, const Monoid &monoid)
+            : window(bucket_width, capacity, monoid), newest_timestamp(), has_timestamp(false) {}
+    };
+
+    Shard *shards;
+    size_type shards_count;
+    Monoid monoid;
+
+    // Threads get consecutive indices on their first push
+    [[nodiscard]] static size_type threadIndex() noexcept {
+        static std::atomic<size_type> next_index{0};
+        thread_local size_type index = next_index.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    void free(size_type constructed_shards) noexcept {
+        for (size_type i = 0; i < constructed_shards; ++i) {
+            shards[i].~Shard();
+        }
+        ::operator delete(shards, std::align_val_t(alignof(Shard)));
+    }
+
+public:
+    // By default one shard per hardware thread
+    explicit ShardedWindowAggregator(const Timestamp &bucket_width = 1, size_type shards_count = 0,
+                                     const size_type &capacity = 100, const Monoid &monoid = Monoid())
+        : shards(nullptr), shards_count(shards_count), monoid(monoid) {
+        if (this->shards_count == 0) {
+            this->shards_count = std::thread::hardware_concurrency();
+            if (this->shards_count == 0) {
+                this->shards_count = 1;
+            }
+        }
+        shards = static_cast<Shard *>(
+            ::operator new(sizeof(Shard) * this->shards_count, std::align_val_t(alignof(Shard))));
+        size_type constructed_shards = 0;
+        try {
+            for (; constructed_shards < this->shards_count; ++constructed_shards) {
+                new (shards + constructed_shards) Shard(bucket_width, capacity, monoid);
+            }
+        } catch (...) {
+            free(constructed_shards);
+            throw;
+        }
+    }
+
+    ShardedWindowAggregator(const ShardedWindowAggregator &other) = delete;
+
+    ShardedWindowAggregator &operator=(const ShardedWindowAggregator &other) = delete;
+
+    ~ShardedWindowAggregator() { free(shards_count); }
+
+    // Capacity
+    [[nodiscard]] size_type getShardsCount() const noexcept { return shards_count; }
+
+    // Requests
+    // Aggregate of all shards, identity if every shard is empty
+    [[nodiscard]] T query() {
+        T aggregate = monoid.identity();
+        for (size_type i = 0; i < shards_count; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            aggregate = monoid(aggregate, shards[i].window.query());
+        }
+        return aggregate;
+    }
+
+    // Modifiers
+    void push(const Timestamp &timestamp, const T &value) {
+        Shard &shard = shards[threadIndex() % shards_count];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.has_timestamp || shard.newest_timestamp < timestamp) {
+            shard.newest_timestamp = timestamp;
+            shard.has_timestamp = true;
+        }
+        shard.window.push(shard.newest_timestamp, value);
+    }
+
+    void evictBefore(const Timestamp &timestamp) {
+        for (size_type i = 0; i < shards_count; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].window.evictBefore(timestamp);
+        }
+    }
+};
+
+#endif // MIN_MAX_QUEUE_SHARDED_WINDOW_AGGREGATOR
@@ -0,0 +1,122 @@
+#ifndef MIN_MAX_QUEUE_SLIDING_WINDOW_AGGREGATOR
+#define MIN_MAX_QUEUE_SLIDING_WINDOW_AGGREGATOR
+#include "../Monoid/Monoid.h"
+#include "../Stack/Stack.h"
+
+// Generalization of Queue<MinMaxNode> to any monoid (see Monoid.h)
+// push_stack keeps only values and the aggregate of all of them, pop_stack keeps for every value
+// the aggregate from it to the newest element of pop_stack. push, pop and query are amortized O(1)
+template <typename T, typename Monoid>
+class SlidingWindowAggregator {
+private:
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+
+    struct Node {
+        T value;
+        T aggregate;
+    };
+
+    size_type size;
+    Stack<T> push_stack;
+    Stack<Node> pop_stack;
+    T push_aggregate;
+    Monoid monoid;
+
+    // Move content of push_stack to pop_stack computing suffix aggregates
+    // pop_stack is empty here, after one reservation the loop has no capacity or emptiness checks
+    void flip() {
+        pop_stack.reserveExtra(push_stack.getSize());
+        if (!push_stack.empty()) {
+            const T &value = push_stack.topUnchecked();
+            pop_stack.pushUnchecked(Node{value, value});
+            push_stack.popUnchecked();
+        }
+        while (!push_stack.empty()) {
+            const T &value = push_stack.topUnchecked();
+            pop_stack.pushUnchecked(Node{value, monoid(value, pop_stack.topUnchecked().aggregate)});
+            push_stack.popUnchecked();
+        }
+        push_aggregate = monoid.identity();
+    }
+
+public:
+    explicit SlidingWindowAggregator(const size_type &capacity = 100, const Monoid &monoid = Monoid())
+        : size(0), push_stack(Stack<T>(capacity)), pop_stack(Stack<Node>(capacity)),
+          push_aggregate(monoid.identity()), monoid(monoid) {}
+
+    SlidingWindowAggregator(const SlidingWindowAggregator<T, Monoid> &other) = default;
+
+    SlidingWindowAggregator &operator=(const SlidingWindowAggregator<T, Monoid> &other) = default;
+
+    SlidingWindowAggregator(SlidingWindowAggregator<T, Monoid> &&other) noexcept = default;
+
+    SlidingWindowAggregator &operator=(SlidingWindowAggregator<T, Monoid> &&other) noexcept = default;
+
+    ~SlidingWindowAggregator() = default;
+
+    // Element access
+    [[nodiscard]] const_reference front() const {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_stack.empty()) {
+            return push_stack.bottomUnchecked();
+        }
+        return pop_stack.topUnchecked().value;
+    }
+
+    [[nodiscard]] const_reference back() const {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (!push_stack.empty()) {
+            return push_stack.topUnchecked();
+        }
+        return pop_stack.bottomUnchecked().value;
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return size == 0; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return size; }
+
+    // Requests
+    // Aggregate of the whole window from the oldest to the newest element, identity if the window is empty
+    [[nodiscard]] T query() const {
+        if (pop_stack.empty()) {
+            return push_aggregate;
+        }
+        if (push_stack.empty()) {
+            return pop_stack.topUnchecked().aggregate;
+        }
+        return monoid(pop_stack.topUnchecked().aggregate, push_aggregate);
+    }
+
+    // Modifiers
+    void pop() {
+        if (size == 0) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_stack.empty()) {
+            flip();
+        }
+        pop_stack.popUnchecked();
+        --size;
+    }
+
+    void push(const T &value) {
+        T new_aggregate = push_stack.empty() ? value : monoid(push_aggregate, value);
+        push_stack.push(value);
+        push_aggregate = std::move(new_aggregate);
+        ++size;
+    }
+
+    void resize(size_type new_capacity) {
+        pop_stack.resize(new_capacity);
+        push_stack.resize(new_capacity);
+    }
+};
+
+#endif // MIN_MAX_QUEUE_SLIDING_WINDOW_AGGREGATOR
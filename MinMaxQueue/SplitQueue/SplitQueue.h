@@ -0,0 +1,418 @@
+#ifndef MIN_MAX_QUEUE_SPLIT_QUEUE
+#define MIN_MAX_QUEUE_SPLIT_QUEUE
+#include "../MinMaxNode/MinMaxNode.h"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+// Queue on two stacks sharing one array: the push stack grows up from the start, the pop stack
+// grows down from the end, so the oldest element is the top of the pop stack at
+// data[capacity - pop_size]
+// Moving the push stack to the empty pop stack keeps the order of elements, so the flip is one
+// backward pass shifting them to the end of the array, with nothing to do for a full array
+// Like Stack the array is allocated on the first push
+template <typename T>
+class SplitQueue {
+private:
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Elements are moved in place, the move can't throw");
+
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+
+    T *data;
+    size_type capacity;
+    size_type push_size;
+    size_type pop_size;
+
+    void swap(SplitQueue<T> &other) noexcept {
+        std::swap(data, other.data);
+        std::swap(capacity, other.capacity);
+        std::swap(push_size, other.push_size);
+        std::swap(pop_size, other.pop_size);
+    }
+
+    void free() noexcept {
+        if (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < push_size; ++i) {
+                (data + i)->~T();
+            }
+            for (size_type i = capacity - pop_size; i < capacity; ++i) {
+                (data + i)->~T();
+            }
+        }
+        ::operator delete(data);
+    }
+
+    // Moves elements from [from, from + count) to [to, to + count), to >= from
+    static void moveBackward(T *from, T *to, size_type count) noexcept {
+        if (from == to || count == 0) {
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(to, from, sizeof(T) * count);
+        } else {
+            for (size_type i = count; i > 0; --i) {
+                new (to + i - 1) T(std::move(from[i - 1]));
+                (from + i - 1)->~T();
+            }
+        }
+    }
+
+    void flip() noexcept {
+        moveBackward(data, data + capacity - push_size, push_size);
+        pop_size = push_size;
+        push_size = 0;
+    }
+
+    // Allocates the reserved capacity on the first push, doubles it later
+    void grow() {
+        size_type new_capacity = data == nullptr && capacity > 0 ? capacity : capacity * 2 + 1;
+        T *new_data = reinterpret_cast<T *>(::operator new(sizeof(T) * new_capacity));
+        if (data != nullptr) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memcpy(new_data, data, sizeof(T) * push_size);
+                std::memcpy(new_data + new_capacity - pop_size, data + capacity - pop_size, sizeof(T) * pop_size);
+            } else {
+                for (size_type i = 0; i < push_size; ++i) {
+                    new (new_data + i) T(std::move(data[i]));
+                    (data + i)->~T();
+                }
+                for (size_type i = 1; i <= pop_size; ++i) {
+                    new (new_data + new_capacity - i) T(std::move(data[capacity - i]));
+                    (data + capacity - i)->~T();
+                }
+            }
+            ::operator delete(data);
+        }
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+public:
+    explicit SplitQueue(const size_type &capacity = 100) noexcept
+        : data(nullptr), capacity(capacity), push_size(0), pop_size(0) {}
+
+    SplitQueue(const SplitQueue<T> &other) : SplitQueue(other.capacity) {
+        if (other.empty()) {
+            return;
+        }
+        data = reinterpret_cast<T *>(::operator new(sizeof(T) * capacity));
+        // The destructor runs if copying throws, so only the sizes have to be kept right
+        for (; push_size < other.push_size; ++push_size) {
+            new (data + push_size) T(other.data[push_size]);
+        }
+        for (; pop_size < other.pop_size; ++pop_size) {
+            new (data + capacity - pop_size - 1) T(other.data[capacity - pop_size - 1]);
+        }
+    }
+
+    SplitQueue &operator=(const SplitQueue<T> &other) {
+        if (this != &other) {
+            SplitQueue<T> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SplitQueue(SplitQueue<T> &&other) noexcept : data(nullptr), capacity(0), push_size(0), pop_size(0) {
+        swap(other);
+    }
+
+    SplitQueue &operator=(SplitQueue<T> &&other) noexcept {
+        if (this != &other) {
+            free();
+            data = nullptr;
+            capacity = 0;
+            push_size = 0;
+            pop_size = 0;
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~SplitQueue() { free(); }
+
+    // Element access
+    [[nodiscard]] reference front() {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_size == 0) {
+            return data[0];
+        }
+        return data[capacity - pop_size];
+    }
+
+    [[nodiscard]] const_reference front() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_size == 0) {
+            return data[0];
+        }
+        return data[capacity - pop_size];
+    }
+
+    [[nodiscard]] reference back() {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_size != 0) {
+            return data[push_size - 1];
+        }
+        return data[capacity - 1];
+    }
+
+    [[nodiscard]] const_reference back() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_size != 0) {
+            return data[push_size - 1];
+        }
+        return data[capacity - 1];
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return push_size + pop_size == 0; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return push_size + pop_size; }
+
+    // Modifiers
+    void pop() {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_size == 0) {
+            flip();
+        }
+        if (!std::is_trivially_destructible_v<T>) {
+            (data + capacity - pop_size)->~T();
+        }
+        --pop_size;
+    }
+
+    void push(const T &value) {
+        if (push_size + pop_size == capacity || data == nullptr) {
+            // value may be an element of this queue, so it's copied before the old array is freed
+            T value_copy(value);
+            grow();
+            new (data + push_size) T(std::move(value_copy));
+        } else {
+            new (data + push_size) T(value);
+        }
+        ++push_size;
+    }
+
+    void push(T &&value) {
+        if (push_size + pop_size == capacity || data == nullptr) {
+            T value_copy(std::move(value));
+            grow();
+            new (data + push_size) T(std::move(value_copy));
+        } else {
+            new (data + push_size) T(std::move(value));
+        }
+        ++push_size;
+    }
+};
+
+// Min/max queue for any arithmetic type on one array
+// The push stack keeps values from the start of the array, the pop stack keeps nodes with min and
+// max from its end. The flip turns values into nodes in one backward pass: a node is at least as
+// big as a value, so the node written for a value never covers values that are still unread
+// capacity is counted in nodes, and push_size + pop_size <= capacity always leaves room for a flip
+template <typename T>
+class SplitQueue<BasicMinMaxNode<T>> {
+private:
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Min/max queue needs an arithmetic type");
+
+    using value_type = T;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = min_max_difference_t<T>;
+    using Node = BasicMinMaxNode<T>;
+
+    Node *nodes;
+    size_type capacity;
+    size_type push_size;
+    size_type pop_size;
+    // Valid only if push_size > 0
+    T push_min;
+    T push_max;
+
+    [[nodiscard]] T *values() noexcept { return reinterpret_cast<T *>(nodes); }
+
+    [[nodiscard]] const T *values() const noexcept { return reinterpret_cast<const T *>(nodes); }
+
+    [[nodiscard]] const Node &popTop() const noexcept { return nodes[capacity - pop_size]; }
+
+    void swap(SplitQueue<Node> &other) noexcept {
+        std::swap(nodes, other.nodes);
+        std::swap(capacity, other.capacity);
+        std::swap(push_size, other.push_size);
+        std::swap(pop_size, other.pop_size);
+        std::swap(push_min, other.push_min);
+        std::swap(push_max, other.push_max);
+    }
+
+    void flip() noexcept {
+        T *pushed = values();
+        Node *target = nodes + capacity - push_size;
+        T min_value = pushed[push_size - 1];
+        T max_value = min_value;
+        for (size_type i = push_size; i > 0; --i) {
+            T value = pushed[i - 1];
+            min_value = value < min_value ? value : min_value;
+            max_value = value > max_value ? value : max_value;
+            target[i - 1] = Node{value, min_value, max_value};
+        }
+        pop_size = push_size;
+        push_size = 0;
+    }
+
+    void grow() {
+        size_type new_capacity = nodes == nullptr && capacity > 0 ? capacity : capacity * 2 + 1;
+        Node *new_nodes = static_cast<Node *>(::operator new(sizeof(Node) * new_capacity));
+        if (nodes != nullptr) {
+            std::memcpy(new_nodes, nodes, sizeof(T) * push_size);
+            std::memcpy(new_nodes + new_capacity - pop_size, nodes + capacity - pop_size, sizeof(Node) * pop_size);
+            ::operator delete(nodes);
+        }
+        nodes = new_nodes;
+        capacity = new_capacity;
+    }
+
+public:
+    explicit SplitQueue(const size_type &capacity = 100) noexcept
+        : nodes(nullptr), capacity(capacity), push_size(0), pop_size(0), push_min(), push_max() {}
+
+    SplitQueue(const SplitQueue<Node> &other)
+        : nodes(nullptr), capacity(other.capacity), push_size(other.push_size), pop_size(other.pop_size),
+          push_min(other.push_min), push_max(other.push_max) {
+        if (other.nodes != nullptr) {
+            nodes = static_cast<Node *>(::operator new(sizeof(Node) * capacity));
+            std::memcpy(nodes, other.nodes, sizeof(T) * push_size);
+            std::memcpy(nodes + capacity - pop_size, other.nodes + capacity - pop_size, sizeof(Node) * pop_size);
+        }
+    }
+
+    SplitQueue &operator=(const SplitQueue<Node> &other) {
+        if (this != &other) {
+            SplitQueue<Node> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SplitQueue(SplitQueue<Node> &&other) noexcept
+        : nodes(nullptr), capacity(0), push_size(0), pop_size(0), push_min(), push_max() {
+        swap(other);
+    }
+
+    SplitQueue &operator=(SplitQueue<Node> &&other) noexcept {
+        if (this != &other) {
+            ::operator delete(nodes);
+            nodes = nullptr;
+            capacity = 0;
+            push_size = 0;
+            pop_size = 0;
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~SplitQueue() { ::operator delete(nodes); }
+
+    // Element access
+    [[nodiscard]] const_reference front() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_size == 0) {
+            return values()[0];
+        }
+        return popTop().self_value;
+    }
+
+    [[nodiscard]] const_reference back() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_size != 0) {
+            return values()[push_size - 1];
+        }
+        return nodes[capacity - 1].self_value;
+    }
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return push_size + pop_size == 0; }
+
+    [[nodiscard]] size_type getSize() const noexcept { return push_size + pop_size; }
+
+    // Requests
+    [[nodiscard]] value_type getMin() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_size == 0) {
+            return popTop().min_value;
+        }
+        if (pop_size == 0) {
+            return push_min;
+        }
+        const value_type &pop_min = popTop().min_value;
+        return push_min < pop_min ? push_min : pop_min;
+    }
+
+    [[nodiscard]] value_type getMax() const {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (push_size == 0) {
+            return popTop().max_value;
+        }
+        if (pop_size == 0) {
+            return push_max;
+        }
+        const value_type &pop_max = popTop().max_value;
+        return push_max > pop_max ? push_max : pop_max;
+    }
+
+    // max - min in T like Queue<MinMaxNode>, wraps around if it doesn't fit
+    [[nodiscard]] value_type getMaxDiff() const { return minMaxDifferenceAsValue(getMin(), getMax()); }
+
+    [[nodiscard]] difference_type getMaxDiffExact() const { return minMaxDifference(getMin(), getMax()); }
+
+    // Modifiers
+    void pop() {
+        if (empty()) {
+            throw std::length_error("Empty queue");
+        }
+        if (pop_size == 0) {
+            flip();
+        }
+        --pop_size;
+    }
+
+    void push(value_type value) {
+        if (push_size + pop_size == capacity || nodes == nullptr) {
+            grow();
+        }
+        values()[push_size] = value;
+        ++push_size;
+        if (push_size == 1) {
+            push_min = value;
+            push_max = value;
+        } else {
+            if (value < push_min) {
+                push_min = value;
+            }
+            if (value > push_max) {
+                push_max = value;
+            }
+        }
+    }
+};
+
+#endif // MIN_MAX_QUEUE_SPLIT_QUEUE
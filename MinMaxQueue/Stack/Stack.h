@@ -1,100 +1,216 @@
 #ifndef MIN_MAX_QUEUE_STACK
 #define MIN_MAX_QUEUE_STACK
+#include "../../MemoryUsage/MemoryUsage.h"
 #include "../MinMaxNode/MinMaxNode.h"
+#include <cstring>
+#include <memory_resource>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+// Storage for the first InlineCapacity elements of a Stack, empty if InlineCapacity == 0
+template <typename T, std::size_t InlineCapacity>
+class StackInlineStorage {
+private:
+    alignas(T) unsigned char storage[sizeof(T) * InlineCapacity];
+
+protected:
+    [[nodiscard]] T *inlineData() noexcept { return reinterpret_cast<T *>(storage); }
+
+    [[nodiscard]] const T *inlineData() const noexcept { return reinterpret_cast<const T *>(storage); }
+};
 
-// Stack implementation with T* dynamic array
 template <typename T>
-class Stack {
+class StackInlineStorage<T, 0> {
+protected:
+    [[nodiscard]] T *inlineData() noexcept { return nullptr; }
+
+    [[nodiscard]] const T *inlineData() const noexcept { return nullptr; }
+};
+
+template <typename T>
+class MoveMinMaxContent;
+
+// Stack implementation with T* dynamic array
+// The array is allocated on the first push, until then data is nullptr and capacity is the size
+// to allocate, so an idle stack costs no memory
+// If InlineCapacity > 0 then the first InlineCapacity elements live inside the object, and the
+// array is allocated only when the stack outgrows them
+// The array comes from a std::pmr::memory_resource, copies and moves use the resource of the source
+template <typename T, std::size_t InlineCapacity = 0>
+class Stack : private StackInlineStorage<T, InlineCapacity> {
 private:
     using reference = T &;
     using const_reference = const T &;
     using size_type = std::size_t;
 
+    static constexpr bool kNothrowRelocation = InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>;
+
+    template <typename Type>
+    friend class MoveMinMaxContent;
+
     T *data;
     size_type size;
     size_type capacity;
+    std::pmr::memory_resource *resource;
 
-    void swap(Stack<T> &other) noexcept {
-        std::swap(data, other.data);
-        std::swap(size, other.size);
-        std::swap(capacity, other.capacity);
+    [[nodiscard]] bool isInline() const noexcept { return InlineCapacity > 0 && data == this->inlineData(); }
+
+    // Leaves other empty, for inline storage elements are moved one by one
+    void stealFrom(Stack &other) noexcept(kNothrowRelocation) {
+        resource = other.resource;
+        if (other.isInline()) {
+            data = this->inlineData();
+            capacity = InlineCapacity;
+            size = 0;
+            uninitializedRelocate(data, other.data, other.size);
+            size = other.size;
+            destroy(other.data, other.size);
+            other.size = 0;
+        } else {
+            data = other.data;
+            size = other.size;
+            capacity = other.capacity;
+            other.data = other.inlineData();
+            other.size = 0;
+            other.capacity = InlineCapacity;
+        }
     }
 
-    static void free(T *data_to_free, size_type destructor_calls) noexcept {
+    static void destroy(T *data_to_destroy, size_type destructor_calls) noexcept {
         if (!std::is_trivially_destructible_v<T>) {
             size_type destroyed_objects = 0;
             while (destroyed_objects < destructor_calls) {
-                (data_to_free + destroyed_objects)->~T();
+                (data_to_destroy + destroyed_objects)->~T();
                 ++destroyed_objects;
             }
         }
-        ::operator delete(data_to_free);
     }
 
-    static void uninitializedCopy(T *copy_to, const Stack<T> &copy_from) {
+    // Inline storage and a not yet allocated array aren't returned to the resource
+    void deallocate(T *data_to_free, size_type allocated_capacity) noexcept {
+        if (data_to_free != nullptr && data_to_free != this->inlineData()) {
+            resource->deallocate(data_to_free, sizeof(T) * allocated_capacity, alignof(T));
+        }
+    }
+
+    void free() noexcept {
+        destroy(data, size);
+        deallocate(data, capacity);
+    }
+
+    // Copies are destroyed if one of them throws, the memory stays with the caller
+    static void uninitializedCopy(T *copy_to, const Stack &copy_from) {
         size_type copied_objects = 0;
         try {
             for (; copied_objects < copy_from.size; ++copied_objects) {
                 new (copy_to + copied_objects) T(copy_from.data[copied_objects]);
             }
         } catch (...) {
-            free(copy_to, copied_objects);
+            destroy(copy_to, copied_objects);
+            throw;
+        }
+    }
+
+    // Moves the elements if T's move can't throw or T can't be copied and copies them otherwise, as
+    // std::vector does, so a throwing copy leaves the source intact
+    // Constructed elements are destroyed if one of them throws, the memory stays with the caller
+    static void uninitializedRelocate(T *relocate_to, T *relocate_from, size_type count) {
+        size_type relocated_objects = 0;
+        try {
+            for (; relocated_objects < count; ++relocated_objects) {
+                new (relocate_to + relocated_objects) T(std::move_if_noexcept(relocate_from[relocated_objects]));
+            }
+        } catch (...) {
+            destroy(relocate_to, relocated_objects);
             throw;
         }
     }
 
+    // A copy keeps the reserved capacity unless its elements fit into inline storage
+    [[nodiscard]] static size_type copyCapacity(const Stack &other) noexcept {
+        return InlineCapacity == 0 || other.size > InlineCapacity ? other.capacity : InlineCapacity;
+    }
+
+    // Moves the elements to an array of new_capacity elements, new_capacity >= size
+    void reallocate(size_type new_capacity) {
+        T *new_data = allocate(new_capacity);
+        bool new_data_inline = new_capacity <= InlineCapacity;
+        try {
+            uninitializedRelocate(new_data, data, size);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+        free();
+        data = new_data;
+        capacity = new_data_inline ? InlineCapacity : new_capacity;
+    }
+
+    // Allocates the reserved capacity on the first push, doubles it later
+    void grow() { reallocate(data == nullptr && capacity > 0 ? capacity : capacity * 2 + 1); }
+
+    // Inline storage if it is big enough, heap memory otherwise
+    [[nodiscard]] T *allocate(size_type new_capacity) {
+        if (new_capacity <= InlineCapacity) {
+            return this->inlineData();
+        }
+        return static_cast<T *>(resource->allocate(sizeof(T) * new_capacity, alignof(T)));
+    }
+
 public:
-    explicit Stack(const size_type &capacity = 100)
-        : data(reinterpret_cast<T *>(::operator new(sizeof(T) * capacity))), size(0), capacity(capacity) {}
+    explicit Stack(const size_type &capacity = InlineCapacity > 0 ? InlineCapacity : 100,
+                   std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+        : data(capacity <= InlineCapacity ? this->inlineData() : nullptr), size(0),
+          capacity(capacity > InlineCapacity ? capacity : InlineCapacity), resource(resource) {}
 
-    Stack(const Stack<T> &other)
-        : data(reinterpret_cast<T *>(::operator new(sizeof(T) * other.capacity))), size(other.size),
-          capacity(other.capacity) {
-        uninitializedCopy(data, other);
+    Stack(const Stack &other) : Stack(copyCapacity(other), other.resource) {
+        if (other.size > 0) {
+            if (data == nullptr) {
+                data = allocate(capacity);
+            }
+            // The destructor runs if copying throws, so the array is freed there
+            uninitializedCopy(data, other);
+            size = other.size;
+        }
     }
 
-    Stack &operator=(const Stack<T> &other) {
+    Stack &operator=(const Stack &other) {
         if (this != &other) {
-            T *new_data = reinterpret_cast<T *>(::operator new(sizeof(T) * other.capacity));
-            uninitializedCopy(new_data, other);
-            free(data, size);
-            data = new_data;
-            size = other.size;
-            capacity = other.capacity;
+            Stack copy(other);
+            *this = std::move(copy);
         }
         return *this;
     }
 
-    Stack(Stack<T> &&other) noexcept : data(nullptr), size(0), capacity(0) { swap(other); }
+    Stack(Stack &&other) noexcept(kNothrowRelocation)
+        : data(nullptr), size(0), capacity(0), resource(other.resource) {
+        stealFrom(other);
+    }
 
-    Stack &operator=(Stack<T> &&other) noexcept {
+    Stack &operator=(Stack &&other) noexcept(kNothrowRelocation) {
         if (this != &other) {
-            free(data, size);
-            data = nullptr;
-            size = 0;
-            capacity = 0;
-            swap(other);
+            free();
+            stealFrom(other);
         }
         return *this;
     }
 
-    ~Stack() { free(data, size); }
+    ~Stack() { free(); }
 
     // Element access
     [[nodiscard]] reference top() {
         if (size == 0) {
             throw std::length_error("Empty stack");
         }
-        return data[size - 1];
+        return topUnchecked();
     }
 
     [[nodiscard]] const_reference top() const {
         if (size == 0) {
             throw std::length_error("Empty stack");
         }
-        return data[size - 1];
+        return topUnchecked();
     }
 
     // Necessary for efficient implementation of a queue on 2 stacks
@@ -102,106 +218,207 @@ public:
         if (size == 0) {
             throw std::length_error("Empty stack");
         }
-        return data[0];
+        return bottomUnchecked();
     }
 
     [[nodiscard]] const_reference bottom() const {
         if (size == 0) {
             throw std::length_error("Empty stack");
         }
-        return data[0];
+        return bottomUnchecked();
     }
 
+    // Unchecked access for callers that already know the stack isn't empty
+    [[nodiscard]] reference topUnchecked() noexcept { return data[size - 1]; }
+
+    [[nodiscard]] const_reference topUnchecked() const noexcept { return data[size - 1]; }
+
+    [[nodiscard]] reference bottomUnchecked() noexcept { return data[0]; }
+
+    [[nodiscard]] const_reference bottomUnchecked() const noexcept { return data[0]; }
+
     // Capacity
     [[nodiscard]] bool empty() const noexcept { return size == 0; }
 
     [[nodiscard]] size_type getSize() const noexcept { return size; }
 
+    // Inline slots are live or reserved while the elements fit in them and overhead once the stack
+    // outgrows them, an array not allocated yet reserves nothing
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        size_type allocated = data == nullptr ? 0 : capacity;
+        size_type object_bytes = sizeof(*this) - (isInline() ? sizeof(T) * InlineCapacity : 0);
+        return {sizeof(T) * size, sizeof(T) * (allocated - size), object_bytes};
+    }
+
     // Modifiers
     void resize(size_type new_capacity) {
-        T *new_data = reinterpret_cast<T *>(::operator new(sizeof(T) * new_capacity));
-        if (std::is_move_constructible_v<T>) {
-            size_type copied_objects = 0;
-            while (copied_objects < size) {
-                new (new_data + copied_objects) T(std::move(data[copied_objects]));
-                ++copied_objects;
-            }
-            ::operator delete(data);
-        } else {
-            uninitializedCopy(new_data, *this);
-            free(data, size);
+        if (new_capacity < size) {
+            throw std::length_error("New capacity is less than size");
         }
-        data = new_data;
-        capacity = new_capacity;
+        if (data == nullptr) {
+            // Still nothing to move, the first push allocates
+            data = new_capacity <= InlineCapacity ? this->inlineData() : nullptr;
+            capacity = new_capacity > InlineCapacity ? new_capacity : InlineCapacity;
+            return;
+        }
+        if (new_capacity <= InlineCapacity && isInline()) {
+            return;
+        }
+        reallocate(new_capacity);
+    }
+
+    // Makes room for extra more elements with at most one reallocation, after it extra pushes
+    // may use pushUnchecked or emplaceUnchecked
+    void reserveExtra(size_type extra) {
+        size_type needed = size + extra;
+        if (data != nullptr && needed <= capacity) {
+            return;
+        }
+        size_type new_capacity = data == nullptr ? capacity : capacity * 2 + 1;
+        reallocate(new_capacity > needed ? new_capacity : needed);
     }
 
     void pop() {
         if (size == 0) {
             throw std::length_error("Empty stack");
         }
+        popUnchecked();
+    }
+
+    // The stack must not be empty
+    void popUnchecked() noexcept {
         if (!std::is_trivially_destructible_v<T>) {
             (data + size - 1)->~T();
         }
         --size;
     }
 
-    void push(const T &value) {
-        if (size == capacity) {
-            resize(capacity * 2 + 1);
+    template <typename... Args>
+    reference emplace(Args &&...args) {
+        if (size == capacity || data == nullptr) {
+            // args may refer to an element of this stack, so the new element is constructed before
+            // the old buffer is freed
+            T value(std::forward<Args>(args)...);
+            grow();
+            new (data + size) T(std::move(value));
+        } else {
+            new (data + size) T(std::forward<Args>(args)...);
+        }
+        return data[size++];
+    }
+
+    void push(const T &value) { emplace(value); }
+
+    void push(T &&value) { emplace(std::move(value)); }
+
+    // There must be room for one more element, see reserveExtra
+    template <typename... Args>
+    reference emplaceUnchecked(Args &&...args) {
+        new (data + size) T(std::forward<Args>(args)...);
+        return data[size++];
+    }
+
+    void pushUnchecked(const T &value) { emplaceUnchecked(value); }
+
+    void pushUnchecked(T &&value) { emplaceUnchecked(std::move(value)); }
+
+    // Undo log for backtracking: a checkpoint is the current size, rollback pops everything pushed
+    // after it, so restoring a state costs O(changes) instead of a copy of the whole stack
+    // A checkpoint stays valid while the stack isn't popped below it
+    [[nodiscard]] size_type checkpoint() const noexcept { return size; }
+
+    // O(1) for trivially destructible types, otherwise elements are destroyed from the top down
+    void rollback(size_type mark) {
+        if (mark > size) {
+            throw std::length_error("Checkpoint is above the top of the stack");
+        }
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            size = mark;
+        } else {
+            while (size > mark) {
+                popUnchecked();
+            }
         }
-        new (data + size) T(value);
-        ++size;
     }
 
-    void push(const T &&value) {
-        if (size == capacity) {
-            resize(capacity * 2 + 1);
+    // undo sees every element from the top down to mark before it is popped
+    template <typename Undo>
+    void rollback(size_type mark, Undo &&undo) {
+        if (mark > size) {
+            throw std::length_error("Checkpoint is above the top of the stack");
+        }
+        while (size > mark) {
+            undo(data[size - 1]);
+            popUnchecked();
         }
-        new (data + size) T(std::move(value));
-        ++size;
     }
 
     // Move content of one push_stack to pop_stack
+    // The whole range is moved in one pass in reverse order after at most one reallocation
     template <typename Type>
     class MoveStackContent {
     public:
         static void get(Stack<Type> &move_to, Stack<Type> &move_from) {
-            if (std::is_move_constructible_v<Type>) {
-                while (!move_from.empty()) {
-                    move_to.push(std::move(move_from.top()));
-                    --move_from.size;
+            size_type count = move_from.size;
+            if (count == 0) {
+                return;
+            }
+            move_to.reserveExtra(count);
+            Type *to = move_to.data + move_to.size;
+            const Type *from = move_from.data + count - 1;
+            if constexpr (std::is_trivially_copyable_v<Type>) {
+                for (size_type i = 0; i < count; ++i) {
+                    std::memcpy(static_cast<void *>(to + i), from - i, sizeof(Type));
+                }
+            } else if constexpr (std::is_nothrow_move_constructible_v<Type>) {
+                for (size_type i = 0; i < count; ++i) {
+                    new (to + i) Type(std::move(move_from.data[count - 1 - i]));
                 }
             } else {
-                while (!move_from.empty()) {
-                    move_to.push(move_from.top());
-                    move_from.pop();
+                // Copies if Type can be copied, so that move_from stays intact if a copy throws
+                Type *last = move_from.data + count - 1;
+                size_type copied_objects = 0;
+                try {
+                    for (; copied_objects < count; ++copied_objects) {
+                        new (to + copied_objects) Type(std::move_if_noexcept(*(last - copied_objects)));
+                    }
+                } catch (...) {
+                    destroy(to, copied_objects);
+                    throw;
                 }
             }
+            destroy(move_from.data, count);
+            move_from.size = 0;
+            move_to.size += count;
         }
     };
 };
 
-// Specialization for a problem condition
-template <>
-template <>
-class Stack<MinMaxNode>::MoveStackContent<MinMaxNode> {
+// Move content of a push stack of values to a pop stack of min/max nodes
+// Necessary for Queue<BasicMinMaxNode<T>>, which doesn't keep min and max for every pushed value
+// After one reservation nodes are written in a single pass without capacity checks or branches,
+// the running min and max are a loop-carried dependency, so the pass is serial but cheap
+template <typename T>
+class MoveMinMaxContent {
 public:
-    static void get(Stack<MinMaxNode> &move_to, Stack<MinMaxNode> &move_from) {
-        while (!move_from.empty()) {
-            if (move_to.empty()) {
-                MinMaxNode &move_from_top = move_from.top();
-                move_to.push(MinMaxNode{move_from_top.self_value, move_from_top.self_value, move_from_top.self_value});
-            } else {
-                MinMaxNode &move_to_top = move_to.top();
-                MinMaxNode &move_from_top = move_from.top();
-                move_to.push(MinMaxNode{move_from_top.self_value,
-                                        move_to_top.min_value < move_from_top.self_value ? move_to_top.min_value
-                                                                                         : move_from_top.self_value,
-                                        move_to_top.max_value > move_from_top.self_value ? move_to_top.max_value
-                                                                                         : move_from_top.self_value});
-            }
-            move_from.pop();
+    static void get(Stack<BasicMinMaxNode<T>> &move_to, Stack<T> &move_from) {
+        std::size_t count = move_from.size;
+        if (count == 0) {
+            return;
+        }
+        move_to.reserveExtra(count);
+        const T *from = move_from.data + count - 1;
+        BasicMinMaxNode<T> *to = move_to.data + move_to.size;
+        T min_value = move_to.size > 0 ? to[-1].min_value : *from;
+        T max_value = move_to.size > 0 ? to[-1].max_value : *from;
+        for (std::size_t i = 0; i < count; ++i) {
+            T value = *(from - i);
+            min_value = value < min_value ? value : min_value;
+            max_value = value > max_value ? value : max_value;
+            to[i] = BasicMinMaxNode<T>{value, min_value, max_value};
         }
+        move_from.size = 0;
+        move_to.size += count;
     }
 };
 
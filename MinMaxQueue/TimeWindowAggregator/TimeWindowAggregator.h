@@ -0,0 +1,134 @@
+#ifndef MIN_MAX_QUEUE_TIME_WINDOW_AGGREGATOR
+#define MIN_MAX_QUEUE_TIME_WINDOW_AGGREGATOR
+#include "../SlidingWindowAggregator/SlidingWindowAggregator.h"
+#include <cstdint>
+
+// Sliding window defined by time instead of element count
+// Values are pre-aggregated into buckets [start, start + bucket_width), so memory is bounded by the
+// number of buckets in the window and not by the event rate. With bucket_width == 1 the window is
+// exact for integer timestamps. A bucket is evicted once all of its timestamps are expired.
+// Timestamps of pushed values must not decrease.
+template <typename T, typename Monoid, typename Timestamp = std::int64_t>
+class TimeWindowAggregator {
+private:
+    using size_type = std::size_t;
+
+    struct Bucket {
+        Timestamp start;
+        T aggregate;
+    };
+
+    class BucketMonoid {
+    private:
+        Monoid monoid;
+
+    public:
+        explicit BucketMonoid(const Monoid &monoid) : monoid(monoid) {}
+
+        [[nodiscard]] Bucket identity() const { return Bucket{Timestamp(), monoid.identity()}; }
+
+        [[nodiscard]] Bucket operator()(const Bucket &left, const Bucket &right) const {
+            return Bucket{left.start, monoid(left.aggregate, right.aggregate)};
+        }
+    };
+
+    // Closed buckets, the newest bucket is kept aside while values can still be added to it
+    SlidingWindowAggregator<Bucket, BucketMonoid> buckets;
+    Bucket open_bucket;
+    bool has_open_bucket;
+    Timestamp bucket_width;
+    Monoid monoid;
+
+    [[nodiscard]] Timestamp bucketStart(Timestamp timestamp) const noexcept {
+        Timestamp remainder = timestamp % bucket_width;
+        if (remainder < 0) {
+            remainder += bucket_width;
+        }
+        return timestamp - remainder;
+    }
+
+    // Whether every timestamp of the bucket starting at start is less than timestamp
+    // Compares distances instead of start + bucket_width, which overflows near the largest timestamp
+    [[nodiscard]] bool expired(const Timestamp &start, const Timestamp &timestamp) const noexcept {
+        if (!(start < timestamp)) {
+            return false;
+        }
+        // A negative start and a non-negative timestamp can be further apart than Timestamp holds
+        if (start < Timestamp() && !(timestamp < Timestamp())) {
+            return !(timestamp - bucket_width < start);
+        }
+        return !(timestamp - start < bucket_width);
+    }
+
+public:
+    explicit TimeWindowAggregator(const Timestamp &bucket_width = 1, const size_type &capacity = 100,
+                                  const Monoid &monoid = Monoid())
+        : buckets(capacity, BucketMonoid(monoid)), open_bucket{Timestamp(), monoid.identity()},
+          has_open_bucket(false), bucket_width(bucket_width), monoid(monoid) {
+        if (!(bucket_width > 0)) {
+            throw std::invalid_argument("Bucket width must be positive");
+        }
+    }
+
+    TimeWindowAggregator(const TimeWindowAggregator &other) = default;
+
+    TimeWindowAggregator &operator=(const TimeWindowAggregator &other) = default;
+
+    TimeWindowAggregator(TimeWindowAggregator &&other) noexcept = default;
+
+    TimeWindowAggregator &operator=(TimeWindowAggregator &&other) noexcept = default;
+
+    ~TimeWindowAggregator() = default;
+
+    // Capacity
+    [[nodiscard]] bool empty() const noexcept { return !has_open_bucket; }
+
+    // Number of buckets in the window
+    [[nodiscard]] size_type getSize() const noexcept { return buckets.getSize() + (has_open_bucket ? 1 : 0); }
+
+    // Start of the oldest bucket in the window
+    [[nodiscard]] Timestamp oldestTimestamp() const {
+        if (!has_open_bucket) {
+            throw std::length_error("Empty window");
+        }
+        return buckets.empty() ? open_bucket.start : buckets.front().start;
+    }
+
+    // Requests
+    // Aggregate of all values in the window, identity if the window is empty
+    [[nodiscard]] T query() const {
+        if (buckets.empty()) {
+            return open_bucket.aggregate;
+        }
+        return monoid(buckets.query().aggregate, open_bucket.aggregate);
+    }
+
+    // Modifiers
+    void push(const Timestamp &timestamp, const T &value) {
+        Timestamp start = bucketStart(timestamp);
+        if (!has_open_bucket) {
+            open_bucket = Bucket{start, value};
+            has_open_bucket = true;
+        } else if (start == open_bucket.start) {
+            open_bucket.aggregate = monoid(open_bucket.aggregate, value);
+        } else if (open_bucket.start < start) {
+            buckets.push(open_bucket);
+            open_bucket = Bucket{start, value};
+        } else {
+            throw std::invalid_argument("Timestamps must not decrease");
+        }
+    }
+
+    // Drop in bulk every bucket whose timestamps are all less than timestamp
+    void evictBefore(const Timestamp &timestamp) {
+        while (!buckets.empty() && expired(buckets.front().start, timestamp)) {
+            buckets.pop();
+        }
+        if (has_open_bucket && buckets.empty() && expired(open_bucket.start, timestamp)) {
+            open_bucket.aggregate = monoid.identity();
+            has_open_bucket = false;
+        }
+    }
+};
+
+#endif // MIN_MAX_QUEUE_TIME_WINDOW_AGGREGATOR
@@ -0,0 +1,161 @@
+#ifndef MIN_MAX_QUEUE_WORK_STEALING_DEQUE
+#define MIN_MAX_QUEUE_WORK_STEALING_DEQUE
+#include "../Stack/Stack.h"
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque: the owner thread pushes and pops at the bottom (LIFO), any number
+// of thief threads steal from the top (FIFO)
+// Elements live in a circular array indexed by ever-growing top and bottom counters, like the ring
+// Queue but with a power of two capacity. When the owner fills it, the array is copied into one
+// twice as big; thieves may still read the old one, so retired arrays are freed only with the deque.
+// Memory ordering follows Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing
+// for Weak Memory Models" (PPoPP 2013).
+// Elements are copied with relaxed atomics, so T must be trivially copyable, e.g. a task pointer
+template <typename T>
+class WorkStealingDeque {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "Elements are read by thieves racing with the owner");
+
+    using size_type = std::size_t;
+    using index_type = std::int64_t;
+
+    static constexpr size_type kCacheLine = 64;
+
+    struct Array {
+        index_type capacity;
+        index_type mask;
+
+        [[nodiscard]] std::atomic<T> *slots() noexcept { return reinterpret_cast<std::atomic<T> *>(this + 1); }
+
+        [[nodiscard]] T get(index_type index) noexcept {
+            return slots()[index & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(index_type index, const T &value) noexcept {
+            slots()[index & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+    static_assert(sizeof(Array) % alignof(std::atomic<T>) == 0, "Slots must stay aligned");
+
+    alignas(kCacheLine) std::atomic<index_type> top;
+    alignas(kCacheLine) std::atomic<index_type> bottom;
+    alignas(kCacheLine) std::atomic<Array *> array;
+    // Owner only
+    Stack<Array *> retired;
+
+    [[nodiscard]] static Array *allocate(index_type capacity) {
+        Array *new_array = static_cast<Array *>(::operator new(sizeof(Array) + sizeof(std::atomic<T>) * capacity));
+        new_array->capacity = capacity;
+        new_array->mask = capacity - 1;
+        for (index_type i = 0; i < capacity; ++i) {
+            new (new_array->slots() + i) std::atomic<T>();
+        }
+        return new_array;
+    }
+
+    // Copies the live range [top_index, bottom_index) into an array twice as big
+    [[nodiscard]] Array *grow(Array *old_array, index_type top_index, index_type bottom_index) {
+        Array *new_array = allocate(old_array->capacity * 2);
+        for (index_type i = top_index; i < bottom_index; ++i) {
+            new_array->put(i, old_array->get(i));
+        }
+        try {
+            retired.push(old_array);
+        } catch (...) {
+            ::operator delete(new_array);
+            throw;
+        }
+        array.store(new_array, std::memory_order_release);
+        return new_array;
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit WorkStealingDeque(size_type capacity = 64) : top(0), bottom(0), array(nullptr), retired(4) {
+        index_type rounded_capacity = 1;
+        while (static_cast<size_type>(rounded_capacity) < capacity) {
+            rounded_capacity *= 2;
+        }
+        array.store(allocate(rounded_capacity), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &other) = delete;
+
+    WorkStealingDeque &operator=(const WorkStealingDeque &other) = delete;
+
+    // No thief may use the deque any more
+    ~WorkStealingDeque() {
+        ::operator delete(array.load(std::memory_order_relaxed));
+        while (!retired.empty()) {
+            ::operator delete(retired.topUnchecked());
+            retired.popUnchecked();
+        }
+    }
+
+    // Capacity
+    // A snapshot, thieves may change it right away
+    [[nodiscard]] bool empty() const noexcept {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+    // Modifiers
+    // Owner only
+    void push(const T &value) {
+        index_type bottom_index = bottom.load(std::memory_order_relaxed);
+        index_type top_index = top.load(std::memory_order_acquire);
+        Array *current_array = array.load(std::memory_order_relaxed);
+        if (bottom_index - top_index > current_array->capacity - 1) {
+            current_array = grow(current_array, top_index, bottom_index);
+        }
+        current_array->put(bottom_index, value);
+        // A release store instead of the paper's release fence, same ordering and visible to TSan
+        bottom.store(bottom_index + 1, std::memory_order_release);
+    }
+
+    // Owner only, empty if the deque is empty or a thief took the last element
+    [[nodiscard]] std::optional<T> pop() noexcept {
+        index_type bottom_index = bottom.load(std::memory_order_relaxed) - 1;
+        Array *current_array = array.load(std::memory_order_relaxed);
+        bottom.store(bottom_index, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        index_type top_index = top.load(std::memory_order_relaxed);
+        if (top_index > bottom_index) {
+            bottom.store(bottom_index + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T value = current_array->get(bottom_index);
+        if (top_index == bottom_index) {
+            // The last element, the owner races with thieves for it
+            bool won = top.compare_exchange_strong(top_index, top_index + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(bottom_index + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return value;
+    }
+
+    // Any thread, empty if the deque is empty or another thread won the race for the top element
+    [[nodiscard]] std::optional<T> steal() noexcept {
+        index_type top_index = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        index_type bottom_index = bottom.load(std::memory_order_acquire);
+        if (top_index >= bottom_index) {
+            return std::nullopt;
+        }
+        T value = array.load(std::memory_order_acquire)->get(top_index);
+        if (!top.compare_exchange_strong(top_index, top_index + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+};
+
+#endif // MIN_MAX_QUEUE_WORK_STEALING_DEQUE
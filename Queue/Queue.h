@@ -1,5 +1,7 @@
 #ifndef BATTLE_QUEUE_RING
 #define BATTLE_QUEUE_RING
+#include "../MemoryUsage/MemoryUsage.h"
+#include <memory_resource>
 #include <stdexcept>
 #include <type_traits>
 
@@ -17,7 +19,7 @@ private:
     using const_reference = const T &;
 
 public:
-    Queue() noexcept : size(0), top_pointer(0), back_pointer(0) {}
+    Queue() noexcept(std::is_nothrow_default_constructible_v<T>) : size(0), top_pointer(0), back_pointer(0) {}
 
     Queue(const Queue<T, N> &other) = default;
 
@@ -65,6 +67,11 @@ public:
 
     [[nodiscard]] std::size_t getSize() const noexcept { return size; }
 
+    // All N slots live inside the object, the free ones are reserved
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        return {sizeof(T) * size, sizeof(T) * (N - size), sizeof(*this) - sizeof(data)};
+    }
+
     // Modifiers
     void pop() {
         if (size == 0) {
@@ -98,7 +105,8 @@ public:
     }
 };
 
-// If N == 0 then allocate memory on heap
+// If N == 0 then allocate memory from a std::pmr::memory_resource, the heap by default
+// Copies and moves use the resource of the source
 template <typename T>
 class Queue<T, 0> {
 private:
@@ -107,6 +115,7 @@ private:
     std::size_t capacity;
     std::size_t top_pointer;
     std::size_t back_pointer;
+    std::pmr::memory_resource *resource;
 
     using reference = T &;
     using const_reference = const T &;
@@ -117,6 +126,17 @@ private:
         std::swap(capacity, other.capacity);
         std::swap(top_pointer, other.top_pointer);
         std::swap(back_pointer, other.back_pointer);
+        std::swap(resource, other.resource);
+    }
+
+    [[nodiscard]] T *allocate(std::size_t new_capacity) {
+        return static_cast<T *>(resource->allocate(sizeof(T) * new_capacity, alignof(T)));
+    }
+
+    void deallocate(T *data_to_free, std::size_t allocated_capacity) noexcept {
+        if (data_to_free != nullptr) {
+            resource->deallocate(data_to_free, sizeof(T) * allocated_capacity, alignof(T));
+        }
     }
 
     void free(std::size_t destructor_calls) noexcept {
@@ -129,7 +149,7 @@ private:
                 ++destroyed_objects;
             }
         }
-        ::operator delete(data);
+        deallocate(data, capacity);
     }
 
     void uninitializedCopy(const Queue<T, 0> &other) {
@@ -148,21 +168,21 @@ private:
 
     void resize() {
         if (capacity == 0) {
-            ::operator delete(data);
+            T *new_data = allocate(1);
+            deallocate(data, capacity);
+            data = new_data;
             capacity = 1;
-            data = reinterpret_cast<T *>(::operator new(sizeof(T) * capacity));
         } else {
             std::size_t new_capacity = capacity * 2;
-            T *new_data = reinterpret_cast<T *>(::operator new(sizeof(T) * new_capacity));
+            T *new_data = allocate(new_capacity);
             std::size_t copied_objects = 0;
             std::size_t old_data_pointer = top_pointer;
-            if (std::is_move_constructible_v<T>) {
+            if constexpr (std::is_nothrow_move_constructible_v<T>) {
                 while (copied_objects < size) {
                     new (new_data + copied_objects) T(std::move(data[old_data_pointer]));
                     ++old_data_pointer %= capacity;
                     ++copied_objects;
                 }
-                ::operator delete(data);
             } else {
                 try {
                     while (copied_objects < size) {
@@ -176,16 +196,12 @@ private:
                             (new_data + j)->~T();
                         }
                     }
-                    ::operator delete(new_data);
+                    deallocate(new_data, new_capacity);
                     throw;
                 }
-                if (!std::is_trivially_destructible_v<T>) {
-                    for (std::size_t i = 0; i < size; ++i) {
-                        (data + i)->~T();
-                    }
-                }
-                ::operator delete(data);
             }
+            // Moved-from objects are destroyed too
+            free(size);
             data = new_data;
             capacity = new_capacity;
             top_pointer = 0;
@@ -194,19 +210,22 @@ private:
     }
 
 public:
-    explicit Queue<T, 0>(std::size_t capacity)
-        : data(reinterpret_cast<T *>(::operator new(sizeof(T) * capacity))), size(0), capacity(capacity),
-          top_pointer(0), back_pointer(0) {}
+    explicit Queue<T, 0>(std::size_t capacity,
+                         std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : data(nullptr), size(0), capacity(capacity), top_pointer(0), back_pointer(0), resource(resource) {
+        data = allocate(capacity);
+    }
 
     Queue(const Queue<T, 0> &other)
-        : data(reinterpret_cast<T *>(::operator new(sizeof(T) * other.capacity))), size(other.size),
-          capacity(other.capacity), top_pointer(0), back_pointer(other.size) {
+        : data(nullptr), size(other.size), capacity(other.capacity), top_pointer(0),
+          back_pointer(other.size == other.capacity ? 0 : other.size), resource(other.resource) {
+        data = allocate(capacity);
         uninitializedCopy(other);
     }
 
     Queue &operator=(const Queue<T, 0> &other) {
         if (this != &other) {
-            T *new_data = reinterpret_cast<T *>(::operator new(sizeof(T) * other.capacity));
+            T *new_data = static_cast<T *>(other.resource->allocate(sizeof(T) * other.capacity, alignof(T)));
             std::size_t copied_objects = 0;
             std::size_t other_data_index = other.top_pointer;
             try {
@@ -216,24 +235,26 @@ public:
                 }
             } catch (...) {
                 if (!std::is_trivially_destructible_v<T>) {
-                    for (std::size_t j = 0; j < copied_objects; ++copied_objects) {
+                    for (std::size_t j = 0; j < copied_objects; ++j) {
                         (new_data + j)->~T();
                     }
                 }
-                ::operator delete(new_data);
+                other.resource->deallocate(new_data, sizeof(T) * other.capacity, alignof(T));
                 throw;
             }
             free(size);
             data = new_data;
+            resource = other.resource;
             size = other.size;
             capacity = other.capacity;
             top_pointer = 0;
-            back_pointer = size;
+            back_pointer = size == capacity ? 0 : size;
         }
         return *this;
     }
 
-    Queue(Queue<T, 0> &&other) noexcept : data(nullptr), size(0), capacity(0), top_pointer(0), back_pointer(0) {
+    Queue(Queue<T, 0> &&other) noexcept
+        : data(nullptr), size(0), capacity(0), top_pointer(0), back_pointer(0), resource(other.resource) {
         swap(other);
     }
 
@@ -288,6 +309,10 @@ public:
 
     [[nodiscard]] std::size_t getSize() const noexcept { return size; }
 
+    [[nodiscard]] MemoryUsage memoryUsage() const noexcept {
+        return {sizeof(T) * size, sizeof(T) * (capacity - size), sizeof(*this)};
+    }
+
     // Modifiers
     void pop() {
         if (size == 0) {
@@ -302,18 +327,26 @@ public:
 
     void push(const T &value) {
         if (size == capacity) {
+            // value may be an element of this queue, so it's copied before the old buffer is freed
+            T value_copy(value);
             resize();
+            new (data + back_pointer) T(std::move(value_copy));
+        } else {
+            new (data + back_pointer) T(value);
         }
-        new (data + back_pointer) T(value);
         ++back_pointer %= capacity;
         ++size;
     }
 
     void push(T &&value) {
         if (size == capacity) {
+            // value may be an element of this queue, so it's moved out before the old buffer is freed
+            T value_moved(std::move(value));
             resize();
+            new (data + back_pointer) T(std::move(value_moved));
+        } else {
+            new (data + back_pointer) T(std::move(value));
         }
-        new (data + back_pointer) T(std::move(value));
         ++back_pointer %= capacity;
         ++size;
     }
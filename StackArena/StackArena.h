@@ -0,0 +1,140 @@
+#ifndef STACK_ARENA
+#define STACK_ARENA
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Bump pointer arena with LIFO release, usable by any std::pmr consumer and by Heap, Map, Queue
+// and Stack of this repository
+// Memory comes from a chain of blocks taken from upstream, every block is twice as big as the
+// previous one. deallocate gives memory back only if it is the latest allocation, everything else
+// is released at once by rewind, which is O(1) and keeps the blocks for reuse.
+// Not thread-safe, one arena is meant to back the containers of one request handler
+class StackArena : public std::pmr::memory_resource {
+private:
+    using size_type = std::size_t;
+
+    struct Block {
+        Block *next;
+        size_type bytes;
+
+        [[nodiscard]] char *begin() noexcept { return reinterpret_cast<char *>(this + 1); }
+
+        [[nodiscard]] char *end() noexcept { return begin() + bytes; }
+    };
+
+    static_assert(sizeof(Block) % alignof(std::max_align_t) == 0, "Block data must stay aligned");
+
+    std::pmr::memory_resource *upstream;
+    // Blocks in the order they are used, blocks after current are free
+    Block *first_block;
+    Block *current_block;
+    char *pointer;
+    char *limit;
+    size_type next_block_bytes;
+
+    [[nodiscard]] static char *alignUp(char *address, size_type alignment) noexcept {
+        std::uintptr_t value = reinterpret_cast<std::uintptr_t>(address);
+        return reinterpret_cast<char *>((value + alignment - 1) & ~(alignment - 1));
+    }
+
+    void useBlock(Block *block) noexcept {
+        current_block = block;
+        pointer = block->begin();
+        limit = block->end();
+    }
+
+    // Moves to the next free block if it fits bytes, otherwise inserts a new block after current
+    void nextBlock(size_type bytes, size_type alignment) {
+        size_type needed = bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+        Block *next = current_block == nullptr ? first_block : current_block->next;
+        if (next != nullptr && next->bytes >= needed) {
+            useBlock(next);
+            return;
+        }
+        size_type block_bytes = next_block_bytes;
+        while (block_bytes < needed) {
+            block_bytes *= 2;
+        }
+        Block *block = static_cast<Block *>(
+            upstream->allocate(sizeof(Block) + block_bytes, alignof(std::max_align_t)));
+        block->next = next;
+        block->bytes = block_bytes;
+        if (current_block == nullptr) {
+            first_block = block;
+        } else {
+            current_block->next = block;
+        }
+        next_block_bytes = block_bytes * 2;
+        useBlock(block);
+    }
+
+protected:
+    void *do_allocate(size_type bytes, size_type alignment) override {
+        char *result = alignUp(pointer, alignment);
+        if (pointer == nullptr || result + bytes > limit) {
+            nextBlock(bytes, alignment);
+            result = alignUp(pointer, alignment);
+        }
+        pointer = result + bytes;
+        return result;
+    }
+
+    // Only the latest allocation is given back, the rest waits for rewind
+    void do_deallocate(void *address, size_type bytes, size_type /* alignment */) override {
+        char *start = static_cast<char *>(address);
+        if (start + bytes == pointer && start >= current_block->begin()) {
+            pointer = start;
+        }
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    // Position of the arena, memory allocated after it is released by rewind
+    class Mark {
+    private:
+        friend StackArena;
+
+        Block *block;
+        char *pointer;
+
+        Mark(Block *block, char *pointer) noexcept : block(block), pointer(pointer) {}
+    };
+
+    explicit StackArena(
+        size_type block_bytes = 64 * 1024,
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream(upstream), first_block(nullptr), current_block(nullptr), pointer(nullptr),
+          limit(nullptr), next_block_bytes(block_bytes > 0 ? block_bytes : 1) {}
+
+    StackArena(const StackArena &other) = delete;
+
+    StackArena &operator=(const StackArena &other) = delete;
+
+    ~StackArena() override {
+        while (first_block != nullptr) {
+            Block *next = first_block->next;
+            upstream->deallocate(first_block, sizeof(Block) + first_block->bytes,
+                                 alignof(std::max_align_t));
+            first_block = next;
+        }
+    }
+
+    [[nodiscard]] Mark mark() const noexcept { return Mark(current_block, pointer); }
+
+    // Releases everything allocated after mark, objects living there must be destroyed before
+    void rewind(const Mark &mark) noexcept {
+        current_block = mark.block;
+        pointer = mark.pointer;
+        limit = current_block == nullptr ? nullptr : current_block->end();
+    }
+
+    // Releases everything, blocks are kept for the next allocations
+    void release() noexcept { rewind(Mark(nullptr, nullptr)); }
+};
+
+#endif // STACK_ARENA
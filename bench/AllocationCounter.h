@@ -0,0 +1,100 @@
+#ifndef CUSTOM_DS_ALLOCATION_COUNTER
+#define CUSTOM_DS_ALLOCATION_COUNTER
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces global operator new and delete to count allocations and live heap bytes, and to make
+// a chosen allocation fail with std::bad_alloc
+// Must be included by exactly one translation unit of a benchmark executable
+namespace allocation_counter {
+
+// Every block starts with a header keeping its size, the header keeps max_align_t alignment
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+inline std::size_t allocations = 0;
+inline std::size_t deallocations = 0;
+inline std::size_t live_bytes = 0;
+inline std::size_t peak_bytes = 0;
+
+// Number of the next allocation that throws, 0 if none
+inline std::size_t fail_countdown = 0;
+
+inline void resetPeak() noexcept { peak_bytes = live_bytes; }
+
+// 0 cancels a pending failure
+inline void failOnAllocation(std::size_t allocation) noexcept { fail_countdown = allocation; }
+
+// Over-aligned blocks take a whole alignment unit for the header, so their data stays aligned
+[[nodiscard]] inline std::size_t headerSize(std::align_val_t alignment) noexcept {
+    std::size_t bytes = static_cast<std::size_t>(alignment);
+    return bytes > kHeaderSize ? bytes : kHeaderSize;
+}
+
+inline void *allocate(std::size_t size, std::size_t header) {
+    if (fail_countdown != 0 && --fail_countdown == 0) {
+        throw std::bad_alloc();
+    }
+    void *block = header == kHeaderSize
+                      ? std::malloc(size + header)
+                      : std::aligned_alloc(header, (size + header + header - 1) / header * header);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t *>(block) = size;
+    ++allocations;
+    live_bytes += size;
+    if (live_bytes > peak_bytes) {
+        peak_bytes = live_bytes;
+    }
+    return static_cast<char *>(block) + header;
+}
+
+inline void deallocate(void *pointer, std::size_t header) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    void *block = static_cast<char *>(pointer) - header;
+    ++deallocations;
+    live_bytes -= *static_cast<std::size_t *>(block);
+    std::free(block);
+}
+
+} // namespace allocation_counter
+
+// std::pmr::new_delete_resource allocates with the aligned overloads, so they are counted as well
+void *operator new(std::size_t size) { return allocation_counter::allocate(size, allocation_counter::kHeaderSize); }
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocation_counter::allocate(size, allocation_counter::headerSize(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+
+void operator delete(void *pointer) noexcept {
+    allocation_counter::deallocate(pointer, allocation_counter::kHeaderSize);
+}
+
+void operator delete[](void *pointer) noexcept { ::operator delete(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { ::operator delete(pointer); }
+
+void operator delete[](void *pointer, std::size_t) noexcept { ::operator delete(pointer); }
+
+void operator delete(void *pointer, std::align_val_t alignment) noexcept {
+    allocation_counter::deallocate(pointer, allocation_counter::headerSize(alignment));
+}
+
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept { ::operator delete(pointer, alignment); }
+
+void operator delete(void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    ::operator delete(pointer, alignment);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t alignment) noexcept {
+    ::operator delete(pointer, alignment);
+}
+
+#endif // CUSTOM_DS_ALLOCATION_COUNTER
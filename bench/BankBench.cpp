@@ -0,0 +1,83 @@
+#include "../MinMaxQueue/Bank/Bank.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kWindows = 1 << 20;
+constexpr std::size_t kQueueWindows = 1 << 16;
+constexpr std::size_t kWindowSize = 8;
+constexpr std::size_t kOperations = 1 << 24;
+
+void reportMemory(const char *name, std::size_t windows, std::size_t bytes) {
+    std::printf("%-48s %12zu windows %10.1f bytes/window\n", name, windows,
+                static_cast<double>(bytes) / static_cast<double>(windows));
+}
+
+void benchBank(std::size_t windows) {
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    MinMaxQueueBank bank(windows);
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        std::size_t key = random.next(windows);
+        bank.push(key, static_cast<int>(random.next(1000000)));
+        if (bank.getSize(key) > kWindowSize) {
+            bank.pop(key);
+        }
+        doNotOptimize(bank.getMaxDiff(key));
+    }
+    report("MinMaxQueueBank push, pop, getMaxDiff", kOperations, timer.elapsedSeconds());
+    reportMemory("MinMaxQueueBank heap", windows, allocation_counter::live_bytes - bytes_before);
+}
+
+void benchQueues(std::size_t windows) {
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    std::vector<Queue<MinMaxNode>> queues;
+    queues.reserve(windows);
+    for (std::size_t i = 0; i < windows; ++i) {
+        queues.emplace_back(100);
+    }
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        Queue<MinMaxNode> &queue = queues[random.next(windows)];
+        queue.push(static_cast<int>(random.next(1000000)));
+        if (queue.getSize() > kWindowSize) {
+            queue.pop();
+        }
+        doNotOptimize(queue.getMaxDiff());
+    }
+    report("Queue<MinMaxNode> push, pop, getMaxDiff", kOperations, timer.elapsedSeconds());
+    reportMemory("Queue<MinMaxNode> heap", windows, allocation_counter::live_bytes - bytes_before);
+}
+
+// Most windows of a big table never see a sample
+void benchIdleQueues(std::size_t windows) {
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    std::size_t allocations_before = allocation_counter::allocations;
+    Timer timer;
+    {
+        std::vector<Queue<MinMaxNode>> queues;
+        queues.reserve(windows);
+        for (std::size_t i = 0; i < windows; ++i) {
+            queues.emplace_back(100);
+        }
+        report("Queue<MinMaxNode> idle construction", windows, timer.elapsedSeconds());
+        reportMemory("Queue<MinMaxNode> idle heap", windows, allocation_counter::live_bytes - bytes_before);
+        std::printf("%-48s %12zu allocations\n", "Queue<MinMaxNode> idle",
+                    allocation_counter::allocations - allocations_before - 1);
+    }
+}
+
+} // namespace
+
+int main() {
+    benchIdleQueues(kWindows);
+    benchQueues(kQueueWindows);
+    benchBank(kQueueWindows);
+    benchBank(kWindows);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "../MinMaxQueue/BatchWindow/BatchWindow.h"
+#include "../MinMaxQueue/MonotonicQueue/MonotonicQueue.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "Bench.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 24;
+
+using Differences = std::vector<min_max_difference_t<int>>;
+
+void benchQueue(const std::vector<int> &input, std::size_t window_size, Differences &diff_output) {
+    Timer timer;
+    Queue<MinMaxNode> window(window_size + 1);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        window.push(input[i]);
+        if (window.getSize() > window_size) {
+            window.pop();
+        }
+        if (i + 1 >= window_size) {
+            diff_output[i + 1 - window_size] = window.getMaxDiffExact();
+        }
+    }
+    report(("Queue<MinMaxNode> window " + std::to_string(window_size)).c_str(), input.size(),
+           timer.elapsedSeconds());
+}
+
+void benchMonotonicQueue(const std::vector<int> &input, std::size_t window_size, Differences &diff_output) {
+    Timer timer;
+    MonotonicQueue<int> window(window_size + 1);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        window.push(input[i]);
+        if (window.getSize() > window_size) {
+            window.pop();
+        }
+        if (i + 1 >= window_size) {
+            diff_output[i + 1 - window_size] = window.getMaxDiffExact();
+        }
+    }
+    report(("MonotonicQueue<int> window " + std::to_string(window_size)).c_str(), input.size(),
+           timer.elapsedSeconds());
+}
+
+void benchBatch(const std::vector<int> &input, std::size_t window_size, Differences &diff_output) {
+    std::size_t outputs = input.size() - window_size + 1;
+    std::vector<int> min_output(outputs);
+    std::vector<int> max_output(outputs);
+    Timer timer;
+    slidingWindowMaxDiff(input.data(), input.size(), window_size, min_output.data(), max_output.data(),
+                         diff_output.data());
+    report(("slidingWindowMaxDiff window " + std::to_string(window_size)).c_str(), input.size(),
+           timer.elapsedSeconds());
+}
+
+} // namespace
+
+int main() {
+    std::vector<int> input(kElements);
+    Random random;
+    for (int &value : input) {
+        value = static_cast<int>(random.next(1000000));
+    }
+    for (std::size_t window_size : {4UL, 64UL, 4096UL}) {
+        Differences expected(kElements - window_size + 1);
+        Differences monotonic(kElements - window_size + 1);
+        Differences batch(kElements - window_size + 1);
+        benchQueue(input, window_size, expected);
+        benchMonotonicQueue(input, window_size, monotonic);
+        benchBatch(input, window_size, batch);
+        if (expected != monotonic) {
+            std::printf("MonotonicQueue mismatch for window %zu\n", window_size);
+            return 1;
+        }
+        if (expected != batch) {
+            std::printf("slidingWindowMaxDiff mismatch for window %zu\n", window_size);
+            return 1;
+        }
+    }
+    return 0;
+}
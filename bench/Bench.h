@@ -0,0 +1,61 @@
+#ifndef CUSTOM_DS_BENCH
+#define CUSTOM_DS_BENCH
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Prevent the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Timer {
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Timer() noexcept : start(std::chrono::steady_clock::now()) {}
+
+    void reset() noexcept { start = std::chrono::steady_clock::now(); }
+
+    [[nodiscard]] double elapsedSeconds() const noexcept {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    [[nodiscard]] std::int64_t elapsedNanoseconds() const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+// Deterministic pseudo random numbers (xorshift64*) so that every benchmark sees the same input
+class Random {
+private:
+    std::uint64_t state;
+
+public:
+    explicit Random(std::uint64_t seed = 0x9E3779B97F4A7C15ULL) noexcept : state(seed == 0 ? 1 : seed) {}
+
+    std::uint64_t next() noexcept {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // Uniform in [0, bound)
+    std::uint64_t next(std::uint64_t bound) noexcept { return next() % bound; }
+};
+
+inline void report(std::FILE *file, const char *name, std::size_t operations, double seconds) {
+    std::fprintf(file, "%-48s %12zu ops %10.3f ms %8.2f ns/op\n", name, operations, seconds * 1e3,
+                 operations == 0 ? 0.0 : seconds * 1e9 / static_cast<double>(operations));
+}
+
+inline void report(const char *name, std::size_t operations, double seconds) {
+    report(stdout, name, operations, seconds);
+}
+
+#endif // CUSTOM_DS_BENCH
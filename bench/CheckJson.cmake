@@ -0,0 +1,32 @@
+# Runs a container benchmark with --json - and fails unless its stdout parses as the results JSON,
+# so report lines can't leak into the stream again. Writes the JSON to OUTPUT if it is set
+# cmake -DBENCH=<executable> -DMAX_SIZE=<n> -DMAX_MEMORY=<MB> [-DOUTPUT=<path>] -P CheckJson.cmake
+cmake_minimum_required(VERSION 3.19)
+
+execute_process(COMMAND ${BENCH} --max-size ${MAX_SIZE} --max-memory ${MAX_MEMORY} --json -
+                OUTPUT_VARIABLE json
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${BENCH} exited with ${result}")
+endif()
+
+string(JSON results_count ERROR_VARIABLE error LENGTH "${json}" results)
+if(error)
+    message(FATAL_ERROR "${BENCH} wrote invalid JSON to stdout: ${error}")
+endif()
+if(results_count EQUAL 0)
+    message(FATAL_ERROR "${BENCH} wrote no results")
+endif()
+math(EXPR last "${results_count} - 1")
+foreach(index RANGE ${last})
+    foreach(field container workload payload_bytes size operations seconds ns_per_op counters_per_op)
+        string(JSON value ERROR_VARIABLE error GET "${json}" results ${index} ${field})
+        if(error)
+            message(FATAL_ERROR "${BENCH} result ${index} has no ${field}")
+        endif()
+    endforeach()
+endforeach()
+
+if(OUTPUT)
+    file(WRITE ${OUTPUT} "${json}")
+endif()
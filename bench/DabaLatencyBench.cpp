@@ -0,0 +1,75 @@
+#include "../MinMaxQueue/DabaAggregator/DabaAggregator.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../MinMaxQueue/SlidingWindowAggregator/SlidingWindowAggregator.h"
+#include "Bench.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kWindow = 1 << 20;
+constexpr std::size_t kMeasuredOperations = 1 << 23;
+
+// Every measured operation is a push, a pop of the oldest element and a max-diff query
+void reportLatencies(const char *name, std::vector<std::int64_t> &latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double q) {
+        return latencies[static_cast<std::size_t>(q * static_cast<double>(latencies.size() - 1))];
+    };
+    std::printf("%-36s p50 %6lld ns  p99 %6lld ns  p99.9 %8lld ns  p99.99 %10lld ns  max %10lld ns\n", name,
+                static_cast<long long>(percentile(0.5)), static_cast<long long>(percentile(0.99)),
+                static_cast<long long>(percentile(0.999)), static_cast<long long>(percentile(0.9999)),
+                static_cast<long long>(latencies.back()));
+}
+
+template <typename Window, typename Push, typename Query>
+void benchLatency(const char *name, Window &window, Push push, Query query) {
+    Random random;
+    for (std::size_t i = 0; i < kWindow; ++i) {
+        push(window, static_cast<int>(random.next(1000000)));
+    }
+    // Touch all memory of the window before measuring so that page faults don't hide in the tail
+    for (std::size_t i = 0; i < 2 * kWindow; ++i) {
+        push(window, static_cast<int>(random.next(1000000)));
+        window.pop();
+    }
+    std::vector<std::int64_t> latencies(kMeasuredOperations);
+    for (std::size_t i = 0; i < kMeasuredOperations; ++i) {
+        int value = static_cast<int>(random.next(1000000));
+        Timer timer;
+        push(window, value);
+        window.pop();
+        doNotOptimize(query(window));
+        latencies[i] = timer.elapsedNanoseconds();
+    }
+    reportLatencies(name, latencies);
+}
+
+} // namespace
+
+int main() {
+    Queue<MinMaxNode> queue(kWindow + 1);
+    benchLatency(
+        "Queue<MinMaxNode>", queue, [](Queue<MinMaxNode> &window, int value) { window.push(value); },
+        [](const Queue<MinMaxNode> &window) { return window.getMaxDiff(); });
+
+    using Aggregator = SlidingWindowAggregator<MinMax<int>, MinMaxMonoid<int>>;
+    Aggregator aggregator(kWindow + 1);
+    benchLatency(
+        "SlidingWindowAggregator<MinMax<int>>", aggregator,
+        [](Aggregator &window, int value) { window.push(MinMax<int>{value, value}); },
+        [](const Aggregator &window) {
+            MinMax<int> min_max = window.query();
+            return min_max.max_value - min_max.min_value;
+        });
+
+    using Daba = DabaAggregator<MinMax<int>, MinMaxMonoid<int>>;
+    Daba daba(kWindow + 1);
+    benchLatency(
+        "DabaAggregator<MinMax<int>>", daba, [](Daba &window, int value) { window.push(MinMax<int>{value, value}); },
+        [](const Daba &window) {
+            MinMax<int> min_max = window.query();
+            return min_max.max_value - min_max.min_value;
+        });
+    return 0;
+}
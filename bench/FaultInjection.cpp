@@ -0,0 +1,505 @@
+// Fault injection for Stack, SegmentedStack, Queue (on 2 stacks), Heap, Map, the window containers
+// and containers on a StackArena
+// Heap templates are defined in Heap.cpp, so it's included here to instantiate Heap<ExcThrowClass>
+// Build: g++ -std=c++17 -O2 FaultInjection.cpp ../Heap/Compare/Compare.cpp
+// Run without arguments to sweep failures (exit code 1 on a leak or a broken guarantee), or with
+// --allocations to print heap allocations per operation
+#include "../Heap/Heap/Heap.cpp"
+#include "../Map/Map.h"
+#include "../MinMaxQueue/Bank/Bank.h"
+#include "../MinMaxQueue/DabaAggregator/DabaAggregator.h"
+#include "../MinMaxQueue/MonotonicQueue/MonotonicQueue.h"
+#include "../MinMaxQueue/QuantileQueue/QuantileQueue.h"
+#include "../MinMaxQueue/SegmentedStack/SegmentedStack.h"
+#include "../MinMaxQueue/SplitQueue/SplitQueue.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "../MinMaxQueue/TimeWindowAggregator/TimeWindowAggregator.h"
+#include "../StackArena/StackArena.h"
+#include "FaultInjection.h"
+#include <functional>
+
+using namespace fault_injection;
+
+namespace {
+
+class ValueMoreCompare {
+public:
+    bool operator()(const ExcThrowClass &left, const ExcThrowClass &right) const {
+        return left.getValue() > right.getValue();
+    }
+};
+
+// Push grows the buffer at sizes 1, 3, 7 and pushes its own top then, a failed push leaves the
+// stack unchanged
+void stackPush() {
+    Stack<ExcThrowClass> stack(1);
+    for (int i = 0; i < 10; ++i) {
+        try {
+            if (i > 0 && (i & (i + 1)) == 0) {
+                stack.push(stack.top());
+            } else {
+                ExcThrowClass value(i);
+                stack.push(value);
+            }
+        } catch (...) {
+            check(stack.getSize() == static_cast<std::size_t>(i), "Stack::push changed size on failure");
+            check(i == 0 || stack.top().getValue() >= 0, "Stack::push damaged top on failure");
+            throw;
+        }
+    }
+}
+
+void stackCopy() {
+    Stack<ExcThrowClass> stack(2);
+    for (int i = 0; i < 5; ++i) {
+        stack.push(ExcThrowClass(i));
+    }
+    Stack<ExcThrowClass> copy(stack);
+    Stack<ExcThrowClass> assigned(1);
+    assigned.push(ExcThrowClass(100));
+    try {
+        assigned = copy;
+    } catch (...) {
+        check(assigned.getSize() == 1 && assigned.top().getValue() == 100, "Stack::operator= isn't strong");
+        throw;
+    }
+    Stack<ExcThrowClass> moved(std::move(copy));
+    moved.resize(16);
+    for (int i = 4; i >= 0; --i) {
+        check(moved.top().getValue() == i && assigned.top().getValue() == i, "Stack lost an element");
+        moved.pop();
+        assigned.pop();
+    }
+}
+
+// Elements move between inline storage and the heap
+void inlineStack() {
+    Stack<ExcThrowClass, 4> stack;
+    for (int i = 0; i < 6; ++i) {
+        stack.push(ExcThrowClass(i));
+    }
+    Stack<ExcThrowClass, 4> copy(stack);
+    copy.pop();
+    copy.pop();
+    copy.resize(4);
+    Stack<ExcThrowClass, 4> moved(std::move(copy));
+    Stack<ExcThrowClass, 4> assigned;
+    assigned.push(ExcThrowClass(100));
+    try {
+        assigned = moved;
+    } catch (...) {
+        check(assigned.getSize() == 1 && assigned.top().getValue() == 100, "Stack::operator= isn't strong");
+        throw;
+    }
+    stack = std::move(moved);
+    for (int i = 3; i >= 0; --i) {
+        check(stack.top().getValue() == i && assigned.top().getValue() == i, "Stack lost an element");
+        stack.pop();
+        assigned.pop();
+    }
+}
+
+// Chunks of 3 elements: pushes of its own top open new chunks, copy and assignment walk all chunks
+void segmentedStackOperations() {
+    SegmentedStack<ExcThrowClass, 3> stack;
+    for (int i = 0; i < 8; ++i) {
+        try {
+            if (i % 3 == 0 && i > 0) {
+                stack.push(stack.top());
+            } else {
+                stack.push(ExcThrowClass(i));
+            }
+        } catch (...) {
+            check(stack.getSize() == static_cast<std::size_t>(i), "SegmentedStack::push changed size on failure");
+            throw;
+        }
+    }
+    SegmentedStack<ExcThrowClass, 3> assigned;
+    assigned.push(ExcThrowClass(100));
+    try {
+        assigned = stack;
+    } catch (...) {
+        check(assigned.getSize() == 1 && assigned.top().getValue() == 100, "SegmentedStack::operator= isn't strong");
+        throw;
+    }
+    SegmentedStack<ExcThrowClass, 3> moved(std::move(stack));
+    while (!moved.empty()) {
+        check(moved.top().getValue() == assigned.top().getValue(), "SegmentedStack copy lost an element");
+        moved.pop();
+        assigned.pop();
+    }
+    check(assigned.empty(), "SegmentedStack copy has extra elements");
+}
+
+void queuePushPop() {
+    Queue<ExcThrowClass> queue(2);
+    int pushed = 0;
+    int popped = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            queue.push(ExcThrowClass(pushed++));
+        }
+        Queue<ExcThrowClass> copy(queue);
+        queue = copy;
+        for (int i = 0; i < 3; ++i) {
+            check(queue.front().getValue() == popped++, "Queue broke FIFO order");
+            queue.pop();
+        }
+    }
+}
+
+// A moved-from queue must be empty: accessors throw instead of reading stacks that were moved away
+template <typename Q>
+void checkMovedFrom(const Q &queue, const char *what) {
+    bool thrown = false;
+    try {
+        doNotOptimize(queue.front());
+    } catch (const std::length_error &) {
+        thrown = true;
+    }
+    check(queue.empty() && queue.getSize() == 0 && thrown, what);
+}
+
+// Both queues on 2 stacks and MonotonicQueue are moved from by construction and by assignment and
+// then reused
+void queueMoves() {
+    Queue<ExcThrowClass> queue(2);
+    queue.push(ExcThrowClass(1));
+    Queue<ExcThrowClass> moved(std::move(queue));
+    checkMovedFrom(queue, "Queue moved from by construction isn't empty");
+    Queue<ExcThrowClass> assigned(2);
+    assigned = std::move(moved);
+    checkMovedFrom(moved, "Queue moved from by assignment isn't empty");
+    queue.push(ExcThrowClass(2));
+    check(queue.front().getValue() == 2 && assigned.front().getValue() == 1, "Queue lost an element in a move");
+
+    Queue<MinMaxNode> min_max(2);
+    min_max.push(5);
+    min_max.push(7);
+    min_max.pop();
+    min_max.push(3);
+    Queue<MinMaxNode> min_max_moved(std::move(min_max));
+    checkMovedFrom(min_max, "Queue<MinMaxNode> moved from by construction isn't empty");
+    bool thrown = false;
+    try {
+        doNotOptimize(min_max.getMin());
+    } catch (const std::length_error &) {
+        thrown = true;
+    }
+    check(thrown, "Queue<MinMaxNode>::getMin of a moved-from queue didn't throw");
+    Queue<MinMaxNode> min_max_assigned(2);
+    min_max_assigned = std::move(min_max_moved);
+    checkMovedFrom(min_max_moved, "Queue<MinMaxNode> moved from by assignment isn't empty");
+    min_max.push(9);
+    check(min_max.getMin() == 9 && min_max.getMax() == 9, "Reused Queue<MinMaxNode> kept old bounds");
+    check(min_max_assigned.getMin() == 3 && min_max_assigned.getMax() == 7, "Queue<MinMaxNode> lost bounds in a move");
+
+    MonotonicQueue<int> monotonic(2);
+    monotonic.push(4);
+    monotonic.push(6);
+    MonotonicQueue<int> monotonic_moved(std::move(monotonic));
+    thrown = false;
+    try {
+        doNotOptimize(monotonic.getMin());
+    } catch (const std::length_error &) {
+        thrown = true;
+    }
+    check(monotonic.empty() && monotonic.getSize() == 0 && thrown, "MonotonicQueue moved from isn't empty");
+    MonotonicQueue<int> monotonic_assigned(2);
+    monotonic_assigned = std::move(monotonic_moved);
+    check(monotonic_moved.empty() && monotonic_moved.getSize() == 0,
+          "MonotonicQueue moved from by assignment isn't empty");
+    monotonic.push(1);
+    monotonic_moved.push(2);
+    check(monotonic.getMax() == 1 && monotonic_moved.getMin() == 2 && monotonic_assigned.getMin() == 4 &&
+              monotonic_assigned.getMax() == 6,
+          "MonotonicQueue lost elements in a move");
+}
+
+// Flips shift elements inside one array, pushes of the front element grow it
+void splitQueuePushPop() {
+    SplitQueue<ExcThrowClass> queue(2);
+    int pushed = 0;
+    int popped = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            queue.push(ExcThrowClass(pushed++));
+        }
+        SplitQueue<ExcThrowClass> copy(queue);
+        queue = copy;
+        for (int i = 0; i < 3; ++i) {
+            check(queue.front().getValue() == popped++, "SplitQueue broke FIFO order");
+            queue.pop();
+        }
+        std::size_t size = queue.getSize();
+        try {
+            queue.push(queue.front());
+        } catch (...) {
+            check(queue.getSize() == size, "SplitQueue::push changed size on failure");
+            throw;
+        }
+        while (!queue.empty()) {
+            queue.pop();
+        }
+        popped = pushed;
+    }
+}
+
+void heapOperations() {
+    ExcThrowClass *values = static_cast<ExcThrowClass *>(::operator new(sizeof(ExcThrowClass) * 7));
+    int constructed = 0;
+    try {
+        for (; constructed < 7; ++constructed) {
+            new (values + constructed) ExcThrowClass((constructed * 5) % 7);
+        }
+        Heap<ExcThrowClass, ValueMoreCompare> heap(values, 7);
+        for (int i = 7; i < 12; ++i) {
+            ExcThrowClass value(i);
+            heap.push(value);
+        }
+        Heap<ExcThrowClass, ValueMoreCompare> copy(heap);
+        heap = copy;
+        for (int i = 11; i >= 0; --i) {
+            check(heap.top().getValue() == i, "Heap broke the order");
+            heap.pop();
+        }
+    } catch (...) {
+        for (int i = 0; i < constructed; ++i) {
+            values[i].~ExcThrowClass();
+        }
+        ::operator delete(values);
+        throw;
+    }
+    for (int i = 0; i < constructed; ++i) {
+        values[i].~ExcThrowClass();
+    }
+    ::operator delete(values);
+}
+
+void mapOperations() {
+    using ExcThrowMap = Map<int, ExcThrowClass, std::less<int>>;
+    using value_type = ExcThrowMap::value_type;
+    ExcThrowMap map;
+    for (int i = 0; i < 8; ++i) {
+        std::size_t size = map.getSize();
+        try {
+            if (i % 2 == 0) {
+                map.insert(value_type(i, ExcThrowClass(i)));
+            } else {
+                value_type value(i, ExcThrowClass(i));
+                map.insert(value);
+            }
+        } catch (...) {
+            check(map.getSize() == size && !map.contains(i), "Map::insert changed the map on failure");
+            throw;
+        }
+    }
+    ExcThrowMap copy(map);
+    map.erase(3);
+    try {
+        map = copy;
+    } catch (...) {
+        check(map.getSize() == 7 && !map.contains(3), "Map::operator= isn't strong");
+        throw;
+    }
+    for (int i = 0; i < 8; ++i) {
+        check(map.find(i)->second.getValue() == i, "Map lost a value");
+    }
+}
+
+// Containers of int, only allocations can fail
+void windowOperations() {
+    SlidingWindowAggregator<int, MaxMonoid<int>> sliding(1);
+    DabaAggregator<int, MaxMonoid<int>> daba(1);
+    MonotonicQueue<int> monotonic(1);
+    QuantileQueue<int> quantile(1);
+    Queue<MinMaxNode> min_max(1);
+    TimeWindowAggregator<int, SumMonoid<int>> time_window(4, 1);
+    MinMaxQueueBank bank(1);
+    bank.addWindow();
+    for (int i = 0; i < 64; ++i) {
+        int value = (i * 37) % 64;
+        sliding.push(value);
+        daba.push(value);
+        monotonic.push(value);
+        quantile.push(value);
+        min_max.push(value);
+        time_window.push(i, value);
+        bank.push(static_cast<std::size_t>(i % 2), value);
+        if (i % 5 == 4) {
+            sliding.pop();
+            daba.pop();
+            monotonic.pop();
+            quantile.pop();
+            min_max.pop();
+            bank.pop(static_cast<std::size_t>(i % 2));
+        }
+    }
+    check(sliding.query() == daba.query() && daba.query() == monotonic.getMax() &&
+              monotonic.getMax() == min_max.getMax(),
+          "Window maximums differ");
+    QuantileQueue<int> quantile_copy(quantile);
+    DabaAggregator<int, MaxMonoid<int>> daba_copy(daba);
+    MonotonicQueue<int> monotonic_copy(monotonic);
+    check(quantile_copy.getSize() == quantile.getSize() && daba_copy.query() == daba.query() &&
+              monotonic_copy.getMax() == monotonic.getMax(),
+          "Copies differ");
+}
+
+// Containers sharing a StackArena with small blocks, so a failing upstream allocation may hit any
+// of them, copies live past a mark and are released by rewind
+void arenaOperations() {
+    using ExcThrowMap = Map<int, ExcThrowClass, std::less<int>>;
+    using value_type = ExcThrowMap::value_type;
+    StackArena arena(128);
+    ExcThrowMap map(&arena);
+    Stack<ExcThrowClass> stack(2, &arena);
+    Heap<ExcThrowClass, ValueMoreCompare> heap(1, &arena);
+    for (int i = 0; i < 6; ++i) {
+        map.insert(value_type(i, ExcThrowClass(i)));
+        stack.push(ExcThrowClass(i));
+        heap.push(ExcThrowClass(i));
+    }
+    StackArena::Mark mark = arena.mark();
+    {
+        ExcThrowMap map_copy(map);
+        Stack<ExcThrowClass> stack_copy(stack);
+        Heap<ExcThrowClass, ValueMoreCompare> heap_copy(heap);
+        check(map_copy.getSize() == 6 && stack_copy.top().getValue() == 5 && heap_copy.top().getValue() == 5,
+              "Copy on an arena lost an element");
+    }
+    arena.rewind(mark);
+    for (int i = 6; i < 10; ++i) {
+        map.insert(value_type(i, ExcThrowClass(i)));
+        stack.push(ExcThrowClass(i));
+    }
+    for (int i = 9; i >= 0; --i) {
+        check(map.find(i)->second.getValue() == i && stack.top().getValue() == i, "Arena lost a value");
+        stack.pop();
+    }
+}
+
+constexpr std::size_t kOperations = 1 << 20;
+
+void reportAllAllocations() {
+    reportAllocations("Stack<int> push", kOperations, [] {
+        Stack<int> stack;
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            stack.push(static_cast<int>(i));
+        }
+    });
+    reportAllocations("Queue<int> push/pop window 1024", kOperations, [] {
+        Queue<int> queue(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            queue.push(static_cast<int>(i));
+            if (queue.getSize() > 1024) {
+                queue.pop();
+            }
+        }
+    });
+    reportAllocations("Queue<MinMaxNode> push/pop window 1024", kOperations, [] {
+        Queue<MinMaxNode> queue(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            queue.push(static_cast<int>(i));
+            if (queue.getSize() > 1024) {
+                queue.pop();
+            }
+        }
+    });
+    reportAllocations("SplitQueue<MinMaxNode> push/pop window 1024", kOperations, [] {
+        SplitQueue<MinMaxNode> queue(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            queue.push(static_cast<int>(i));
+            if (queue.getSize() > 1024) {
+                queue.pop();
+            }
+        }
+    });
+    reportAllocations("Heap<int> push/pop", kOperations, [] {
+        Heap<int, MoreCompare<int>> heap;
+        for (std::size_t i = 0; i < kOperations / 2; ++i) {
+            heap.push(static_cast<int>(i * 7919 % kOperations));
+        }
+        while (!heap.empty()) {
+            heap.pop();
+        }
+    });
+    reportAllocations("Map<int, int> insert/erase", kOperations, [] {
+        Map<int, int, std::less<int>> map;
+        for (std::size_t i = 0; i < kOperations / 2; ++i) {
+            map.insert({static_cast<int>(i * 7919 % kOperations), 0});
+        }
+        for (std::size_t i = 0; i < kOperations / 2; ++i) {
+            map.erase(static_cast<int>(i * 7919 % kOperations));
+        }
+    });
+    reportAllocations("SlidingWindowAggregator push/pop window 1024", kOperations, [] {
+        SlidingWindowAggregator<int, MaxMonoid<int>> window(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            window.push(static_cast<int>(i));
+            if (window.getSize() > 1024) {
+                window.pop();
+            }
+        }
+    });
+    reportAllocations("DabaAggregator push/pop window 1024", kOperations, [] {
+        DabaAggregator<int, MaxMonoid<int>> window(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            window.push(static_cast<int>(i));
+            if (window.getSize() > 1024) {
+                window.pop();
+            }
+        }
+    });
+    reportAllocations("MonotonicQueue push/pop window 1024", kOperations, [] {
+        MonotonicQueue<int> window(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            window.push(static_cast<int>(i));
+            if (window.getSize() > 1024) {
+                window.pop();
+            }
+        }
+    });
+    reportAllocations("QuantileQueue push/pop window 1024", kOperations, [] {
+        QuantileQueue<int> window(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            window.push(static_cast<int>(i));
+            if (window.getSize() > 1024) {
+                window.pop();
+            }
+        }
+    });
+    reportAllocations("MinMaxQueueBank 1024 windows push/pop", kOperations, [] {
+        MinMaxQueueBank bank(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            std::size_t key = i % 1024;
+            bank.push(key, static_cast<int>(i));
+            if (bank.getSize(key) > 16) {
+                bank.pop(key);
+            }
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (allocationsMode(argc, argv)) {
+        reportAllAllocations();
+        return 0;
+    }
+    ExcThrowClass::setThrowPeriod(0);
+    sweepAll("Stack push", stackPush);
+    sweepAll("Stack copy/assign/move/resize", stackCopy);
+    sweepAll("Stack with inline storage", inlineStack);
+    sweepAll("SegmentedStack push/copy/pop", segmentedStackOperations);
+    sweepAll("Queue push/pop/copy", queuePushPop);
+    sweepAll("Queue and MonotonicQueue moves", queueMoves);
+    sweepAll("SplitQueue push/pop/copy", splitQueuePushPop);
+    sweepAll("Heap build/push/copy/pop", heapOperations);
+    sweepAll("Map insert/copy/erase", mapOperations);
+    sweep("Window containers push/pop/copy", Fault::kAllocation, windowOperations);
+    sweepAll("Map, Stack and Heap on a StackArena", arenaOperations);
+    return failed ? 1 : 0;
+}
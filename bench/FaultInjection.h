@@ -0,0 +1,100 @@
+#ifndef CUSTOM_DS_FAULT_INJECTION
+#define CUSTOM_DS_FAULT_INJECTION
+#include "../MinMaxQueue/ExcThrowClass/ExcThrowClass.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+// Shared part of the fault injection harnesses
+// A scenario is a callable that builds containers, runs operations on them and lets any exception
+// escape. sweep() runs it with the 1st, 2nd, ... construction of ExcThrowClass (or allocation)
+// failing until a run finishes before the failure point, and after every run checks that all
+// objects and heap bytes are released
+namespace fault_injection {
+
+enum class Fault { kConstruction, kAllocation };
+
+inline bool failed = false;
+
+// Records a broken guarantee without stopping the sweep
+inline void check(bool condition, const char *what) {
+    if (!condition) {
+        std::printf("    check failed: %s\n", what);
+        failed = true;
+    }
+}
+
+inline void arm(Fault fault, std::size_t fail_point) noexcept {
+    if (fault == Fault::kConstruction) {
+        ExcThrowClass::failOnConstruction(static_cast<unsigned int>(fail_point));
+    } else {
+        allocation_counter::failOnAllocation(fail_point);
+    }
+}
+
+// Returns true if the failure was not triggered
+inline bool disarm(Fault fault) noexcept {
+    bool pending = fault == Fault::kConstruction ? ExcThrowClass::failurePending()
+                                                 : allocation_counter::fail_countdown != 0;
+    ExcThrowClass::failOnConstruction(0);
+    allocation_counter::failOnAllocation(0);
+    return pending;
+}
+
+template <typename Scenario>
+void sweep(const char *name, Fault fault, Scenario scenario) {
+    std::size_t fail_points = 0;
+    for (std::size_t fail_point = 1;; ++fail_point) {
+        std::size_t live_bytes = allocation_counter::live_bytes;
+        unsigned int live_objects = ExcThrowClass::getLiveObjects();
+        arm(fault, fail_point);
+        try {
+            scenario();
+        } catch (const std::bad_alloc &) {
+        } catch (const std::runtime_error &) {
+            // ExcThrowClass failures
+        }
+        bool pending = disarm(fault);
+        if (allocation_counter::live_bytes != live_bytes || ExcThrowClass::getLiveObjects() != live_objects) {
+            std::printf("    leak when failing at %zu: %zd bytes, %d objects\n", fail_point,
+                        static_cast<std::ptrdiff_t>(allocation_counter::live_bytes - live_bytes),
+                        static_cast<int>(ExcThrowClass::getLiveObjects() - live_objects));
+            failed = true;
+        }
+        if (pending) {
+            break;
+        }
+        ++fail_points;
+    }
+    std::printf("%-48s %-12s %6zu fail points\n", name,
+                fault == Fault::kConstruction ? "construction" : "allocation", fail_points);
+}
+
+template <typename Scenario>
+void sweepAll(const char *name, Scenario scenario) {
+    sweep(name, Fault::kConstruction, scenario);
+    sweep(name, Fault::kAllocation, scenario);
+}
+
+// Perf regression mode: heap allocations made by operations per operation
+template <typename Operations>
+void reportAllocations(const char *name, std::size_t operations, Operations run) {
+    std::size_t allocations = allocation_counter::allocations;
+    allocation_counter::resetPeak();
+    std::size_t base_bytes = allocation_counter::live_bytes;
+    run();
+    allocations = allocation_counter::allocations - allocations;
+    std::printf("%-48s %12zu ops %10.4f allocations/op %12zu peak bytes\n", name, operations,
+                static_cast<double>(allocations) / static_cast<double>(operations),
+                allocation_counter::peak_bytes - base_bytes);
+}
+
+[[nodiscard]] inline bool allocationsMode(int argc, char **argv) {
+    return argc > 1 && std::strcmp(argv[1], "--allocations") == 0;
+}
+
+} // namespace fault_injection
+
+#endif // CUSTOM_DS_FAULT_INJECTION
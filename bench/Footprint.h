@@ -0,0 +1,120 @@
+#ifndef CUSTOM_DS_BENCH_FOOTPRINT
+#define CUSTOM_DS_BENCH_FOOTPRINT
+#include "../MemoryUsage/MemoryUsage.h"
+#include "Bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Resident memory per element of a container against what its memoryUsage() reports
+// Every measurement builds its container in a forked child, so memory an earlier one freed and the
+// allocator kept doesn't absorb the growth of the next. The RSS delta also has allocator headers,
+// size class rounding and fragmentation, which memoryUsage() can't see, and misses reserved pages
+// nothing touched yet
+// Usage: <benchmark> [--max-size N]   sizes go 10^4, 10^5, ... up to N, 10^6 by default
+namespace footprint {
+
+[[nodiscard]] inline std::vector<std::size_t> parseSizes(int argc, char **argv) {
+    std::size_t max_size = 1000000;
+    if (argc == 3 && std::strcmp(argv[1], "--max-size") == 0) {
+        max_size = std::strtoull(argv[2], nullptr, 10);
+    } else if (argc != 1) {
+        std::fprintf(stderr, "Usage: %s [--max-size N]\n", argv[0]);
+        std::exit(2);
+    }
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = 10000; size <= max_size; size *= 10) {
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+// Resident bytes of the process, 0 where it isn't known
+[[nodiscard]] inline std::size_t residentBytes() {
+#ifdef __linux__
+    std::FILE *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long long total_pages = 0;
+    unsigned long long resident_pages = 0;
+    int fields = std::fscanf(file, "%llu %llu", &total_pages, &resident_pages);
+    std::fclose(file);
+    return fields == 2 ? static_cast<std::size_t>(resident_pages * sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+template <typename Container>
+[[nodiscard]] MemoryUsage usageOf(const Container &container) noexcept {
+    return container.memoryUsage();
+}
+
+// Containers too big for the stack are built on the heap
+template <typename Container>
+[[nodiscard]] MemoryUsage usageOf(const std::unique_ptr<Container> &container) noexcept {
+    return container->memoryUsage();
+}
+
+// A forked child maps code and allocator pages in as it first touches them, a small build and a
+// first read of the RSS do that before the baseline
+constexpr std::size_t kWarmUpSize = 64;
+
+template <typename Build>
+void measureInProcess(const std::string &name, std::size_t size, Build &build) {
+    {
+        auto warm_up = build(size < kWarmUpSize ? size : kWarmUpSize);
+        doNotOptimize(residentBytes());
+    }
+    std::size_t before = residentBytes();
+    auto container = build(size);
+    std::size_t after = residentBytes();
+    MemoryUsage usage = usageOf(container);
+    double elements = static_cast<double>(size);
+    std::printf("%-48s live %7.2f reserved %7.2f overhead %7.2f", (name + " n=" + std::to_string(size)).c_str(),
+                static_cast<double>(usage.live_bytes) / elements, static_cast<double>(usage.reserved_bytes) / elements,
+                static_cast<double>(usage.overhead_bytes) / elements);
+    if (after == 0) {
+        std::printf(" bytes/element\n");
+        return;
+    }
+    double resident = after > before ? static_cast<double>(after - before) : 0.0;
+    std::printf(" RSS %7.2f bytes/element  RSS/reported %.2f\n", resident / elements,
+                resident / static_cast<double>(usage.total()));
+}
+
+// build(size) returns a container holding size elements
+template <typename Build>
+void measure(const std::string &name, std::size_t size, Build build) {
+    std::fflush(stdout);
+#ifdef __linux__
+    pid_t child = fork();
+    if (child > 0) {
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::fprintf(stderr, "%s n=%zu failed\n", name.c_str(), size);
+        }
+        return;
+    }
+    if (child == 0) {
+        measureInProcess(name, size, build);
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+#endif
+    // No fork, the numbers after the first measurement are less reliable
+    measureInProcess(name, size, build);
+}
+
+} // namespace footprint
+
+#endif // CUSTOM_DS_BENCH_FOOTPRINT
@@ -0,0 +1,71 @@
+// Bytes per element of Stack, Heap, Map and the queue on 2 stacks: memoryUsage() against RSS
+// Queues are measured after one pop, when every element has moved to pop_stack and push_stack keeps
+// its array
+#include "../Heap/Heap/Heap.h"
+#include "../Map/Map.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "Footprint.h"
+#include "Suite.h"
+#include <functional>
+
+using namespace suite;
+
+namespace {
+
+// Distinct keys in random order, an odd multiplier is a bijection on 64 bits
+[[nodiscard]] std::uint64_t scatter(std::size_t i) noexcept { return i * 0x9E3779B97F4A7C15ULL; }
+
+template <typename T>
+void measureStack(const std::string &name, std::size_t size) {
+    footprint::measure(name, size, [](std::size_t count) {
+        Stack<T> stack;
+        for (std::size_t i = 0; i < count; ++i) {
+            stack.push(makeValue<T>(i));
+        }
+        return stack;
+    });
+}
+
+template <typename T>
+void measureMap(const std::string &name, std::size_t size) {
+    footprint::measure(name, size, [](std::size_t count) {
+        Map<std::uint64_t, T, std::less<std::uint64_t>> map;
+        for (std::size_t i = 0; i < count; ++i) {
+            map.insert({scatter(i), makeValue<T>(i)});
+        }
+        return map;
+    });
+}
+
+template <typename Element, typename Value>
+void measureQueue(const std::string &name, std::size_t size) {
+    footprint::measure(name, size, [](std::size_t count) {
+        Queue<Element> queue(100);
+        for (std::size_t i = 0; i <= count; ++i) {
+            queue.push(makeValue<Value>(i));
+        }
+        queue.pop();
+        return queue;
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    for (std::size_t size : footprint::parseSizes(argc, argv)) {
+        measureStack<int>("Stack<int>", size);
+        measureStack<Payload<32>>("Stack<Payload<32>>", size);
+        footprint::measure("Heap<int>", size, [](std::size_t count) {
+            Heap<int, MoreCompare<int>> heap;
+            for (std::size_t i = 0; i < count; ++i) {
+                heap.push(static_cast<int>(scatter(i)));
+            }
+            return heap;
+        });
+        measureMap<std::uint64_t>("Map<uint64_t, uint64_t>", size);
+        measureMap<Payload<32>>("Map<uint64_t, Payload<32>>", size);
+        measureQueue<int, int>("Queue<int>", size);
+        measureQueue<MinMaxNode, int>("Queue<MinMaxNode>", size);
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Heap against std::priority_queue for several payload sizes and key distributions
+// Heap.cpp is included because only Heap<int, MoreCompare<int>> is instantiated there
+#include "../Heap/Heap/Heap.cpp"
+#include "Suite.h"
+#include "Workload.h"
+#include <queue>
+#include <vector>
+
+using namespace suite;
+
+namespace {
+
+// The shipped instantiation for int, an inline comparator for the payloads
+template <typename T>
+using KthHeap = Heap<T, std::conditional_t<std::is_same_v<T, int>, MoreCompare<int>, Greater<T>>>;
+
+// Both are max-heaps
+template <typename T>
+using PriorityQueue = std::priority_queue<T>;
+
+constexpr std::uint64_t kKeyRange = 1u << 30;
+
+// Push orders: random, timestamps (every push into a max-heap sifts up to the root), descending (no
+// push sifts at all) and interleaved ascending runs
+const workload::Distribution kPushOrders[] = {workload::Distribution::uniform(), workload::Distribution::timestamps(),
+                                              workload::Distribution::descending(),
+                                              workload::Distribution::sawtooth(64)};
+
+template <typename T>
+void benchPushPop(Results &results, std::size_t size, const workload::Distribution &order) {
+    std::vector<std::uint64_t> keys = workload::generate(order, size, kKeyRange, size);
+    std::string workload = "push/pop " + order.name();
+    results.measure("Heap", workload, sizeof(T), size, [&keys] {
+        KthHeap<T> heap;
+        for (std::uint64_t key : keys) {
+            heap.push(makeValue<T>(key));
+        }
+        while (!heap.empty()) {
+            doNotOptimize(heap.top());
+            heap.pop();
+        }
+        return 2 * keys.size();
+    });
+    results.measure("std::priority_queue", workload, sizeof(T), size, [&keys] {
+        PriorityQueue<T> queue;
+        for (std::uint64_t key : keys) {
+            queue.push(makeValue<T>(key));
+        }
+        while (!queue.empty()) {
+            doNotOptimize(queue.top());
+            queue.pop();
+        }
+        return 2 * keys.size();
+    });
+}
+
+// Builds from an unordered array in one go
+template <typename T>
+void benchBuild(Results &results, const std::vector<std::uint64_t> &keys) {
+    std::vector<T> values;
+    values.reserve(keys.size());
+    for (std::uint64_t key : keys) {
+        values.push_back(makeValue<T>(key));
+    }
+    results.measure("Heap", "build", sizeof(T), keys.size(), [&values] {
+        KthHeap<T> heap(values.data(), values.size());
+        doNotOptimize(heap.top());
+        return values.size();
+    });
+    results.measure("std::priority_queue", "build", sizeof(T), keys.size(), [&values] {
+        PriorityQueue<T> queue(values.begin(), values.end());
+        doNotOptimize(queue.top());
+        return values.size();
+    });
+}
+
+// Scheduler-like: every operation pops the top and pushes a new element, the size stays put
+// The first size keys fill the heap and the rest are pushed, timestamps keep rising over repetitions
+template <typename T>
+void benchMixed(Results &results, std::size_t size, const workload::Distribution &order) {
+    std::vector<std::uint64_t> keys = workload::generate(order, 2 * size, kKeyRange, size);
+    std::uint64_t shift = order.shape == workload::Shape::kTimestamps ? keys.back() + 1 : 0;
+    std::string workload = "mixed " + order.name();
+    {
+        KthHeap<T> heap;
+        for (std::size_t i = 0; i < size; ++i) {
+            heap.push(makeValue<T>(keys[i]));
+        }
+        results.measure("Heap", workload, sizeof(T), size,
+                        [size, shift, &heap, &keys, round = std::uint64_t(0)]() mutable {
+                            for (std::size_t i = 0; i < size; ++i) {
+                                heap.pop();
+                                heap.push(makeValue<T>(keys[size + i] + round * shift));
+                            }
+                            ++round;
+                            return 2 * size;
+                        });
+    }
+    PriorityQueue<T> queue;
+    for (std::size_t i = 0; i < size; ++i) {
+        queue.push(makeValue<T>(keys[i]));
+    }
+    results.measure("std::priority_queue", workload, sizeof(T), size,
+                    [size, shift, &queue, &keys, round = std::uint64_t(0)]() mutable {
+                        for (std::size_t i = 0; i < size; ++i) {
+                            queue.pop();
+                            queue.push(makeValue<T>(keys[size + i] + round * shift));
+                        }
+                        ++round;
+                        return 2 * size;
+                    });
+}
+
+template <typename T>
+void benchPayload(Results &results) {
+    for (std::size_t size : results.sizes()) {
+        // The array grows by doubling, build also keeps the source array, mixed has 2 keys per element
+        if (!results.fits(size, 3 * sizeof(T) + 2 * sizeof(std::uint64_t))) {
+            break;
+        }
+        for (const workload::Distribution &order : kPushOrders) {
+            benchPushPop<T>(results, size, order);
+        }
+        benchBuild<T>(results, workload::generate(workload::Distribution::uniform(), size, kKeyRange, size));
+        benchMixed<T>(results, size, workload::Distribution::uniform());
+        benchMixed<T>(results, size, workload::Distribution::timestamps());
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Results results("HeapBench", parseOptions(argc, argv));
+    benchPayload<int>(results);
+    benchPayload<Payload<32>>(results);
+    benchPayload<Payload<256>>(results);
+    return results.finish();
+}
@@ -0,0 +1,79 @@
+#include "../MinMaxQueue/LockFreeStack/LockFreeStack.h"
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "Bench.h"
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOperationsPerThread = 1 << 20;
+constexpr std::size_t kCapacity = 1 << 16;
+
+// Every thread pushes and pops in random order, like workers sharing a pool of free items
+template <typename Push, typename Pop>
+void runThreads(const std::string &name, std::size_t threads_count, Push push, Pop pop) {
+    Timer timer;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threads_count; ++t) {
+        threads.emplace_back([t, &push, &pop]() {
+            Random random(t + 1);
+            for (std::size_t i = 0; i < kOperationsPerThread; ++i) {
+                if (random.next(2) == 0) {
+                    push(static_cast<int>(i));
+                } else {
+                    pop();
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    report((name + " threads " + std::to_string(threads_count)).c_str(), kOperationsPerThread * threads_count,
+           timer.elapsedSeconds());
+}
+
+void benchLockedStack(std::size_t threads_count) {
+    std::mutex mutex;
+    Stack<int> stack(kCapacity);
+    runThreads(
+        "mutex + Stack<int>", threads_count,
+        [&mutex, &stack](int value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stack.getSize() < kCapacity) {
+                stack.push(value);
+            }
+        },
+        [&mutex, &stack]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!stack.empty()) {
+                doNotOptimize(stack.topUnchecked());
+                stack.popUnchecked();
+            }
+        });
+}
+
+void benchLockFreeStack(std::size_t threads_count, std::size_t slots_count) {
+    LockFreeStack<int> stack(kCapacity, slots_count);
+    runThreads(
+        "LockFreeStack<int> slots " + std::to_string(slots_count), threads_count,
+        [&stack](int value) { doNotOptimize(stack.tryPush(value)); },
+        [&stack]() { doNotOptimize(stack.pop()); });
+}
+
+} // namespace
+
+int main() {
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 4) {
+        max_threads = 4;
+    }
+    for (std::size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+        benchLockedStack(threads_count);
+        benchLockFreeStack(threads_count, 0);
+        benchLockFreeStack(threads_count, 8);
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Map (AA tree) against std::map (red-black tree) for several payload sizes and key distributions
+#include "../Map/Map.h"
+#include "Suite.h"
+#include "Workload.h"
+#include <functional>
+#include <map>
+#include <vector>
+
+using namespace suite;
+
+namespace {
+
+template <typename T>
+using AATree = Map<std::uint64_t, T, std::less<std::uint64_t>>;
+
+template <typename T>
+using RedBlackTree = std::map<std::uint64_t, T>;
+
+constexpr std::uint64_t kKeyRange = UINT64_MAX;
+
+// Insert orders: random, the sorted orders that cascade splits and skews, and interleaved runs
+const workload::Distribution kInsertOrders[] = {workload::Distribution::uniform(),
+                                                workload::Distribution::ascending(),
+                                                workload::Distribution::descending(),
+                                                workload::Distribution::sawtooth(64)};
+
+const workload::Distribution kLookups[] = {workload::Distribution::uniform(), workload::Distribution::zipf(0.99)};
+
+template <typename Tree, typename T>
+void fill(Tree &tree, const std::vector<std::uint64_t> &keys) {
+    for (std::uint64_t key : keys) {
+        tree.insert({key, makeValue<T>(key)});
+    }
+}
+
+// Keys of the tree picked by ranks of the distribution, the tree's keys are in random order so
+// frequent ranks are scattered over the tree
+[[nodiscard]] std::vector<std::uint64_t> pickKeys(const std::vector<std::uint64_t> &keys,
+                                                  const workload::Distribution &distribution) {
+    std::vector<std::uint64_t> picked = workload::generate(distribution, keys.size(), keys.size(), keys.size() + 1);
+    for (std::uint64_t &key : picked) {
+        key = keys[key];
+    }
+    return picked;
+}
+
+template <typename Tree, typename T>
+void benchTree(Results &results, const char *container, std::size_t size) {
+    for (const workload::Distribution &order : kInsertOrders) {
+        std::vector<std::uint64_t> keys = workload::generate(order, size, kKeyRange, size);
+        results.measure(container, "insert " + order.name(), sizeof(T), size, [&keys] {
+            Tree tree;
+            fill<Tree, T>(tree, keys);
+            return keys.size();
+        });
+    }
+
+    std::vector<std::uint64_t> keys = workload::generate(workload::Distribution::uniform(), size, kKeyRange, size);
+    Tree tree;
+    fill<Tree, T>(tree, keys);
+    for (const workload::Distribution &lookup : kLookups) {
+        std::vector<std::uint64_t> lookup_keys = pickKeys(keys, lookup);
+        results.measure(container, "find " + lookup.name(), sizeof(T), size, [&lookup_keys, &tree] {
+            for (std::uint64_t key : lookup_keys) {
+                doNotOptimize(tree.find(key));
+            }
+            return lookup_keys.size();
+        });
+    }
+    results.measure(container, "iteration", sizeof(T), size, [&tree] {
+        std::uint64_t sum = 0;
+        std::size_t visited = 0;
+        for (const auto &entry : tree) {
+            sum += entry.first;
+            ++visited;
+        }
+        doNotOptimize(sum);
+        return visited;
+    });
+
+    // 80% finds, 10% inserts and 10% erases of skewed keys, half of them missing, the size stays put
+    std::vector<std::uint64_t> mixed_keys = pickKeys(keys, kLookups[1]);
+    workload::OperationMix mix({8, 1, 1}, size);
+    Random random(size + 1);
+    results.measure(container, "mixed " + kLookups[1].name(), sizeof(T), size, [&mixed_keys, &tree, &mix, &random] {
+        for (std::uint64_t picked : mixed_keys) {
+            std::uint64_t key = picked + random.next(2);
+            std::size_t operation = mix.next();
+            if (operation == 0) {
+                doNotOptimize(tree.find(key));
+            } else if (operation == 1) {
+                tree.insert({key, makeValue<T>(key)});
+            } else {
+                tree.erase(key);
+            }
+        }
+        return mixed_keys.size();
+    });
+
+    // Every repetition erases a fresh tree in random order
+    results.measure(
+        container, "erase", sizeof(T), size,
+        [&keys] {
+            Tree erased_tree;
+            fill<Tree, T>(erased_tree, keys);
+            return erased_tree;
+        },
+        [&keys](Tree &erased_tree) {
+            for (std::uint64_t key : keys) {
+                erased_tree.erase(key);
+            }
+            return keys.size();
+        });
+}
+
+template <typename T>
+void benchPayload(Results &results) {
+    for (std::size_t size : results.sizes()) {
+        // A node of five words and a separately allocated entry, both with allocator headers, and
+        // the key and lookup vectors
+        if (!results.fits(size, 5 * sizeof(void *) + 3 * sizeof(std::uint64_t) + sizeof(T) + 32)) {
+            break;
+        }
+        benchTree<AATree<T>, T>(results, "Map", size);
+        benchTree<RedBlackTree<T>, T>(results, "std::map", size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Results results("MapBench", parseOptions(argc, argv));
+    benchPayload<int>(results);
+    benchPayload<Payload<32>>(results);
+    benchPayload<Payload<256>>(results);
+    return results.finish();
+}
@@ -0,0 +1,64 @@
+#include "../MinMaxQueue/MonotonicQueue/MonotonicQueue.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 22;
+
+std::vector<int> randomInput() {
+    std::vector<int> input(kElements);
+    Random random;
+    for (int &value : input) {
+        value = static_cast<int>(random.next(1000000));
+    }
+    return input;
+}
+
+// Worst case for the max deque: every element stays a candidate
+std::vector<int> decreasingInput() {
+    std::vector<int> input(kElements);
+    for (std::size_t i = 0; i < kElements; ++i) {
+        input[i] = static_cast<int>(kElements - i);
+    }
+    return input;
+}
+
+template <typename Window>
+void benchWindow(const std::string &name, const std::vector<int> &input, std::size_t window_size) {
+    allocation_counter::resetPeak();
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    Timer timer;
+    {
+        Window window(100);
+        for (int value : input) {
+            window.push(value);
+            if (window.getSize() > window_size) {
+                window.pop();
+            }
+            doNotOptimize(window.getMaxDiff());
+        }
+    }
+    double seconds = timer.elapsedSeconds();
+    report(name.c_str(), input.size(), seconds);
+    std::printf("%-48s peak %10zu bytes\n", "", allocation_counter::peak_bytes - bytes_before);
+}
+
+} // namespace
+
+int main() {
+    std::vector<int> random_input = randomInput();
+    std::vector<int> decreasing_input = decreasingInput();
+    for (std::size_t window_size : {16UL, 1024UL, 65536UL}) {
+        std::string suffix = " window " + std::to_string(window_size);
+        benchWindow<Queue<MinMaxNode>>("Queue<MinMaxNode> random" + suffix, random_input, window_size);
+        benchWindow<MonotonicQueue<int>>("MonotonicQueue<int> random" + suffix, random_input, window_size);
+        benchWindow<Queue<MinMaxNode>>("Queue<MinMaxNode> decreasing" + suffix, decreasing_input, window_size);
+        benchWindow<MonotonicQueue<int>>("MonotonicQueue<int> decreasing" + suffix, decreasing_input,
+                                         window_size);
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+#ifndef CUSTOM_DS_PERF_COUNTERS
+#define CUSTOM_DS_PERF_COUNTERS
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware performance counters of the calling thread (user space only) through perf_event_open
+// Every event is opened on its own, so an event the CPU or the kernel doesn't support is just
+// missing; in a VM without a PMU, with perf_event_paranoid > 2 or off Linux they all are, and the
+// benchmarks report time only. When there are more events than hardware counters the kernel
+// multiplexes them, the counts are scaled by the share of time each event was counting
+class PerfCounters {
+public:
+    enum Event { kCycles, kInstructions, kL1dMisses, kLlcMisses, kDtlbMisses, kBranchMisses, kEventsCount };
+
+    [[nodiscard]] static const char *name(int event) noexcept {
+        static const char *const kNames[kEventsCount] = {"cycles",     "instructions", "l1d_misses",
+                                                         "llc_misses", "dtlb_misses",  "branch_misses"};
+        return kNames[event];
+    }
+
+private:
+    struct Reading {
+        std::uint64_t value;
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+    };
+
+    int descriptors[kEventsCount];
+    // Readings at the last reset, counts are differences from them
+    Reading baseline[kEventsCount];
+
+#ifdef __linux__
+    [[nodiscard]] static std::uint64_t cacheConfig(std::uint64_t cache, std::uint64_t result) noexcept {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    }
+
+    [[nodiscard]] static int open(std::uint32_t type, std::uint64_t config) noexcept {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = type;
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    [[nodiscard]] Reading read(int event) const noexcept {
+        Reading reading{0, 0, 0};
+        if (::read(descriptors[event], &reading, sizeof(reading)) != static_cast<ssize_t>(sizeof(reading))) {
+            return Reading{0, 0, 0};
+        }
+        return reading;
+    }
+
+    void control(unsigned long request) noexcept {
+        for (int event = 0; event < kEventsCount; ++event) {
+            if (descriptors[event] >= 0) {
+                ioctl(descriptors[event], request, 0);
+            }
+        }
+    }
+#endif
+
+public:
+    PerfCounters() noexcept {
+        for (int event = 0; event < kEventsCount; ++event) {
+            descriptors[event] = -1;
+            baseline[event] = Reading{0, 0, 0};
+        }
+#ifdef __linux__
+        descriptors[kCycles] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        // Why every other event failed, if even cycles can't be counted
+        int cycles_error = errno;
+        descriptors[kInstructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        descriptors[kL1dMisses] =
+            open(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        descriptors[kLlcMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        descriptors[kDtlbMisses] =
+            open(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        descriptors[kBranchMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        if (descriptors[kCycles] < 0) {
+            std::fprintf(stderr, "Hardware counters unavailable (%s), reporting time only\n",
+                         std::strerror(cycles_error));
+        }
+#else
+        std::fprintf(stderr, "Hardware counters need Linux, reporting time only\n");
+#endif
+    }
+
+    PerfCounters(const PerfCounters &other) = delete;
+
+    PerfCounters &operator=(const PerfCounters &other) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int descriptor : descriptors) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] bool available(int event) const noexcept { return descriptors[event] >= 0; }
+
+    [[nodiscard]] bool anyAvailable() const noexcept {
+        for (int descriptor : descriptors) {
+            if (descriptor >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Counts restart from zero, start and stop pairs after it add up
+    void reset() noexcept {
+#ifdef __linux__
+        for (int event = 0; event < kEventsCount; ++event) {
+            if (descriptors[event] >= 0) {
+                baseline[event] = read(event);
+            }
+        }
+#endif
+    }
+
+    void start() noexcept {
+#ifdef __linux__
+        control(PERF_EVENT_IOC_ENABLE);
+#endif
+    }
+
+    void stop() noexcept {
+#ifdef __linux__
+        control(PERF_EVENT_IOC_DISABLE);
+#endif
+    }
+
+    // Events since the last reset, scaled up if the event was multiplexed, 0 if unavailable
+    [[nodiscard]] double count(int event) const noexcept {
+#ifdef __linux__
+        if (descriptors[event] < 0) {
+            return 0;
+        }
+        Reading reading = read(event);
+        double value = static_cast<double>(reading.value - baseline[event].value);
+        std::uint64_t enabled = reading.time_enabled - baseline[event].time_enabled;
+        std::uint64_t running = reading.time_running - baseline[event].time_running;
+        if (running == 0) {
+            return 0;
+        }
+        return running < enabled ? value * static_cast<double>(enabled) / static_cast<double>(running) : value;
+#else
+        (void)event;
+        return 0;
+#endif
+    }
+};
+
+#endif // CUSTOM_DS_PERF_COUNTERS
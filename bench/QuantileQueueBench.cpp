@@ -0,0 +1,63 @@
+#include "../MinMaxQueue/QuantileQueue/QuantileQueue.h"
+#include "Bench.h"
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOperations = 1 << 18;
+
+// Every step on a full window pushes a value, evicts the oldest one and asks for the median and p99
+void benchQuantileQueue(std::size_t window_size) {
+    QuantileQueue<int> window(window_size + 1);
+    Random random;
+    for (std::size_t i = 0; i < window_size; ++i) {
+        window.push(static_cast<int>(random.next(1000000)));
+    }
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        window.push(static_cast<int>(random.next(1000000)));
+        if (window.getSize() > window_size) {
+            window.pop();
+        }
+        doNotOptimize(window.getQuantile(0.5));
+        doNotOptimize(window.getQuantile(0.99));
+    }
+    report(("QuantileQueue window " + std::to_string(window_size)).c_str(), kOperations, timer.elapsedSeconds());
+}
+
+// Re-sorting is O(n log n) per step, so fewer steps are measured for big windows
+void benchResort(std::size_t window_size) {
+    std::size_t operations = kOperations * 16 / window_size;
+    std::deque<int> window;
+    std::vector<int> sorted;
+    Random random;
+    for (std::size_t i = 0; i < window_size; ++i) {
+        window.push_back(static_cast<int>(random.next(1000000)));
+    }
+    Timer timer;
+    for (std::size_t i = 0; i < operations; ++i) {
+        window.push_back(static_cast<int>(random.next(1000000)));
+        if (window.size() > window_size) {
+            window.pop_front();
+        }
+        sorted.assign(window.begin(), window.end());
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t last = sorted.size() - 1;
+        doNotOptimize(sorted[static_cast<std::size_t>(0.5 * static_cast<double>(last))]);
+        doNotOptimize(sorted[static_cast<std::size_t>(0.99 * static_cast<double>(last))]);
+    }
+    report(("re-sort window " + std::to_string(window_size)).c_str(), operations, timer.elapsedSeconds());
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t window_size : {16UL, 256UL, 4096UL}) {
+        benchQuantileQueue(window_size);
+        benchResort(window_size);
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Queue on 2 stacks and Queue<MinMaxNode> against std::queue (std::deque) for several payload sizes,
+// the min/max queue against std::queue with a std::multiset of the window
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "Suite.h"
+#include "Workload.h"
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace suite;
+
+namespace {
+
+// Fills the container to size, then empties it
+template <typename Fifo, typename T>
+[[nodiscard]] std::size_t fillAndDrain(Fifo &fifo, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        fifo.push(makeValue<T>(i));
+    }
+    while (!fifo.empty()) {
+        doNotOptimize(fifo.front());
+        fifo.pop();
+    }
+    return 2 * size;
+}
+
+// Sliding window: every operation pushes one element and pops the oldest, the size stays put
+template <typename Fifo, typename T>
+[[nodiscard]] std::size_t slide(Fifo &fifo, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        fifo.push(makeValue<T>(i));
+        doNotOptimize(fifo.front());
+        fifo.pop();
+    }
+    return 2 * size;
+}
+
+template <typename T>
+void benchQueues(Results &results, std::size_t size) {
+    results.measure("Queue", "push/pop", sizeof(T), size, [size] {
+        Queue<T> queue(16);
+        return fillAndDrain<Queue<T>, T>(queue, size);
+    });
+    results.measure("std::queue", "push/pop", sizeof(T), size, [size] {
+        std::queue<T> queue;
+        return fillAndDrain<std::queue<T>, T>(queue, size);
+    });
+    {
+        Queue<T> queue(16);
+        for (std::size_t i = 0; i < size; ++i) {
+            queue.push(makeValue<T>(i));
+        }
+        results.measure("Queue", "sliding window", sizeof(T), size,
+                        [size, &queue] { return slide<Queue<T>, T>(queue, size); });
+    }
+    std::queue<T> queue;
+    for (std::size_t i = 0; i < size; ++i) {
+        queue.push(makeValue<T>(i));
+    }
+    results.measure("std::queue", "sliding window", sizeof(T), size,
+                    [size, &queue] { return slide<std::queue<T>, T>(queue, size); });
+}
+
+// Window of size values, every operation slides it by one and asks for max - min
+// The first size values fill the window and the rest are pushed
+void benchMinMaxQueues(Results &results, std::size_t size, const workload::Distribution &distribution) {
+    std::vector<std::uint64_t> values = workload::generate(distribution, 2 * size, 1u << 30, size);
+    std::string workload = "sliding max - min " + distribution.name();
+    {
+        Queue<MinMaxNode> queue(16);
+        for (std::size_t i = 0; i < size; ++i) {
+            queue.push(static_cast<int>(values[i]));
+        }
+        results.measure("Queue<MinMaxNode>", workload, sizeof(int), size, [size, &queue, &values] {
+            for (std::size_t i = 0; i < size; ++i) {
+                queue.push(static_cast<int>(values[size + i]));
+                queue.pop();
+                doNotOptimize(queue.getMaxDiff());
+            }
+            return size;
+        });
+    }
+    std::queue<int> queue;
+    std::multiset<int> window;
+    for (std::size_t i = 0; i < size; ++i) {
+        queue.push(static_cast<int>(values[i]));
+        window.insert(static_cast<int>(values[i]));
+    }
+    results.measure("std::multiset window", workload, sizeof(int), size, [size, &queue, &window, &values] {
+        for (std::size_t i = 0; i < size; ++i) {
+            int value = static_cast<int>(values[size + i]);
+            queue.push(value);
+            window.insert(value);
+            window.erase(window.find(queue.front()));
+            queue.pop();
+            doNotOptimize(*window.rbegin() - *window.begin());
+        }
+        return size;
+    });
+}
+
+template <typename T>
+void benchPayload(Results &results) {
+    for (std::size_t size : results.sizes()) {
+        // Both stacks double, and the pop stack is filled while the push stack still holds everything
+        if (!results.fits(size, 4 * sizeof(T))) {
+            break;
+        }
+        benchQueues<T>(results, size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Results results("QueueBench", parseOptions(argc, argv));
+    benchPayload<int>(results);
+    benchPayload<Payload<32>>(results);
+    benchPayload<Payload<256>>(results);
+    for (std::size_t size : results.sizes()) {
+        // A std::multiset node per element dominates, then the 2 values per element
+        if (!results.fits(size, 80)) {
+            break;
+        }
+        // Random values, and rising ones, where the front is always the minimum
+        benchMinMaxQueues(results, size, workload::Distribution::uniform());
+        benchMinMaxQueues(results, size, workload::Distribution::ascending());
+    }
+    return results.finish();
+}
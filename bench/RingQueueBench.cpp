@@ -0,0 +1,103 @@
+// Ring buffer Queue<T, N> and Queue<T, 0> against std::queue (std::deque) for several payload sizes
+// Separate from QueueBench because the ring buffer shares its name with the queue on 2 stacks
+#include "../Queue/Queue.h"
+#include "Suite.h"
+#include <memory>
+#include <queue>
+
+using namespace suite;
+
+namespace {
+
+// Fills the container to size, then empties it
+template <typename Fifo, typename T>
+[[nodiscard]] std::size_t fillAndDrain(Fifo &fifo, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        fifo.push(makeValue<T>(i));
+    }
+    while (!fifo.empty()) {
+        doNotOptimize(fifo.front());
+        fifo.pop();
+    }
+    return 2 * size;
+}
+
+// Sliding window: every operation pushes one element and pops the oldest, the size stays put
+template <typename Fifo, typename T>
+[[nodiscard]] std::size_t slide(Fifo &fifo, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        fifo.push(makeValue<T>(i));
+        doNotOptimize(fifo.front());
+        fifo.pop();
+    }
+    return 2 * size;
+}
+
+// Queue<T, N> never grows, so it only runs at the sizes it was compiled for
+template <typename T, std::size_t N>
+void benchFixedQueue(Results &results, std::size_t size) {
+    if (size != N) {
+        return;
+    }
+    // Large N doesn't fit on the stack
+    std::unique_ptr<Queue<T, N>> queue = std::make_unique<Queue<T, N>>();
+    results.measure("Queue<T, N>", "push/pop", sizeof(T), N,
+                    [&queue] { return fillAndDrain<Queue<T, N>, T>(*queue, N); });
+    for (std::size_t i = 0; i < N; ++i) {
+        queue->push(makeValue<T>(i));
+    }
+    results.measure("Queue<T, N>", "sliding window", sizeof(T), N,
+                    [&queue] { return slide<Queue<T, N>, T>(*queue, N); });
+}
+
+template <typename T>
+void benchGrowingQueues(Results &results, std::size_t size) {
+    results.measure("Queue<T, 0>", "push/pop", sizeof(T), size, [size] {
+        Queue<T, 0> queue(16);
+        return fillAndDrain<Queue<T, 0>, T>(queue, size);
+    });
+    results.measure("std::queue", "push/pop", sizeof(T), size, [size] {
+        std::queue<T> queue;
+        return fillAndDrain<std::queue<T>, T>(queue, size);
+    });
+    {
+        Queue<T, 0> queue(16);
+        for (std::size_t i = 0; i < size; ++i) {
+            queue.push(makeValue<T>(i));
+        }
+        results.measure("Queue<T, 0>", "sliding window", sizeof(T), size,
+                        [size, &queue] { return slide<Queue<T, 0>, T>(queue, size); });
+    }
+    std::queue<T> queue;
+    for (std::size_t i = 0; i < size; ++i) {
+        queue.push(makeValue<T>(i));
+    }
+    results.measure("std::queue", "sliding window", sizeof(T), size,
+                    [size, &queue] { return slide<std::queue<T>, T>(queue, size); });
+}
+
+template <typename T>
+void benchPayload(Results &results) {
+    for (std::size_t size : results.sizes()) {
+        // The ring doubles, so a copy of the old one lives next to the new one while it grows
+        if (!results.fits(size, 3 * sizeof(T))) {
+            break;
+        }
+        benchFixedQueue<T, 10>(results, size);
+        benchFixedQueue<T, 100>(results, size);
+        benchFixedQueue<T, 1000>(results, size);
+        benchFixedQueue<T, 10000>(results, size);
+        benchFixedQueue<T, 100000>(results, size);
+        benchGrowingQueues<T>(results, size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Results results("RingQueueBench", parseOptions(argc, argv));
+    benchPayload<int>(results);
+    benchPayload<Payload<32>>(results);
+    benchPayload<Payload<256>>(results);
+    return results.finish();
+}
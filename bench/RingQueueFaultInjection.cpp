@@ -0,0 +1,126 @@
+// Fault injection for the ring buffer Queue, separate because it shares its name with the queue on
+// 2 stacks
+// Run without arguments to sweep failures (exit code 1 on a leak or a broken guarantee), or with
+// --allocations to print heap allocations per operation
+#include "../Queue/Queue.h"
+#include "FaultInjection.h"
+
+using namespace fault_injection;
+
+namespace {
+
+// Pushes wrap around the ring before it grows, the front is pushed again when the queue is full
+void heapQueuePushPop() {
+    Queue<ExcThrowClass, 0> queue(2);
+    int expected[16];
+    std::size_t expected_front = 0;
+    std::size_t expected_back = 0;
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            std::size_t size = queue.getSize();
+            try {
+                if (size == 3) {
+                    queue.push(queue.front());
+                    expected[expected_back++] = expected[expected_front];
+                } else {
+                    ExcThrowClass value(round * 3 + i);
+                    queue.push(value);
+                    expected[expected_back++] = round * 3 + i;
+                }
+            } catch (...) {
+                check(queue.getSize() == size, "Queue::push changed size on failure");
+                throw;
+            }
+        }
+        check(queue.front().getValue() == expected[expected_front++], "Queue broke FIFO order");
+        queue.pop();
+        check(queue.back().getValue() == expected[expected_back - 1], "Queue lost the back");
+    }
+}
+
+// A full queue moves its own front into the back, which grows the ring under the reference
+void heapQueuePushOwnFront() {
+    Queue<ExcThrowClass, 0> queue(2);
+    queue.push(ExcThrowClass(1));
+    queue.push(ExcThrowClass(2));
+    queue.push(std::move(queue.front()));
+    check(queue.getSize() == 3 && queue.back().getValue() == 1, "Queue::push(T &&) lost its own front");
+    queue.pop();
+    check(queue.front().getValue() == 2, "Queue::push(T &&) broke FIFO order");
+}
+
+void heapQueueCopy() {
+    Queue<ExcThrowClass, 0> queue(4);
+    // Full and wrapped around
+    for (int i = 0; i < 7; ++i) {
+        queue.push(ExcThrowClass(i));
+        if (i % 2 == 1) {
+            queue.pop();
+        }
+    }
+    Queue<ExcThrowClass, 0> copy(queue);
+    Queue<ExcThrowClass, 0> assigned(1);
+    assigned.push(ExcThrowClass(100));
+    try {
+        assigned = copy;
+    } catch (...) {
+        check(assigned.getSize() == 1 && assigned.front().getValue() == 100, "Queue::operator= isn't strong");
+        throw;
+    }
+    Queue<ExcThrowClass, 0> moved(std::move(copy));
+    // A full copy must wrap around after a pop
+    moved.pop();
+    assigned.pop();
+    moved.push(ExcThrowClass(7));
+    assigned.push(ExcThrowClass(7));
+    for (int i = 4; i <= 7; ++i) {
+        check(moved.front().getValue() == i && assigned.front().getValue() == i, "Queue lost an element");
+        moved.pop();
+        assigned.pop();
+    }
+}
+
+void stackQueue() {
+    Queue<ExcThrowClass, 4> queue;
+    for (int i = 0; i < 6; ++i) {
+        ExcThrowClass value(i);
+        queue.push(value);
+    }
+    Queue<ExcThrowClass, 4> copy(queue);
+    check(copy.front().getValue() == 2 && copy.back().getValue() == 5, "Queue overwrote wrong elements");
+}
+
+constexpr std::size_t kOperations = 1 << 20;
+
+void reportAllAllocations() {
+    reportAllocations("Queue<int, 0> push", kOperations, [] {
+        Queue<int, 0> queue(1);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            queue.push(static_cast<int>(i));
+        }
+    });
+    reportAllocations("Queue<int, 0> push/pop window 1024", kOperations, [] {
+        Queue<int, 0> queue(1024);
+        for (std::size_t i = 0; i < kOperations; ++i) {
+            queue.push(static_cast<int>(i));
+            if (queue.getSize() > 1024) {
+                queue.pop();
+            }
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (allocationsMode(argc, argv)) {
+        reportAllAllocations();
+        return 0;
+    }
+    ExcThrowClass::setThrowPeriod(0);
+    sweepAll("Queue<T, 0> push/pop", heapQueuePushPop);
+    sweepAll("Queue<T, 0> push own front", heapQueuePushOwnFront);
+    sweepAll("Queue<T, 0> copy/assign/move", heapQueueCopy);
+    sweepAll("Queue<T, N> push/copy", stackQueue);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+// Bytes per element of the ring buffer Queue<T, 0> and Queue<T, N>: memoryUsage() against RSS
+// Separate from FootprintBench because the ring buffer shares its name with the queue on 2 stacks
+#include "../Queue/Queue.h"
+#include "Footprint.h"
+#include "Suite.h"
+#include <memory>
+
+using namespace suite;
+
+namespace {
+
+// Fixed ring, sizes up to it fill part of the slots
+constexpr std::size_t kFixedCapacity = 1 << 20;
+
+template <typename T>
+void measureRing(const std::string &name, std::size_t size) {
+    footprint::measure(name, size, [](std::size_t count) {
+        Queue<T, 0> queue(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            queue.push(makeValue<T>(i));
+        }
+        return queue;
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    for (std::size_t size : footprint::parseSizes(argc, argv)) {
+        measureRing<int>("Queue<int, 0>", size);
+        measureRing<Payload<32>>("Queue<Payload<32>, 0>", size);
+        if (size <= kFixedCapacity) {
+            footprint::measure("Queue<int, 2^20>", size, [](std::size_t count) {
+                auto queue = std::make_unique<Queue<int, kFixedCapacity>>();
+                for (std::size_t i = 0; i < count; ++i) {
+                    queue->push(static_cast<int>(i));
+                }
+                return queue;
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "../MinMaxQueue/SegmentedStack/SegmentedStack.h"
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kPushes = 1 << 24;
+constexpr std::size_t kBoundaryRounds = 1 << 22;
+
+// Latency of every push into a growing stack, growth of Stack shows in the tail
+template <typename S>
+void benchPushLatency(const char *name) {
+    std::vector<std::int64_t> latencies(kPushes);
+    S stack;
+    Timer total;
+    for (std::size_t i = 0; i < kPushes; ++i) {
+        Timer timer;
+        stack.push(static_cast<int>(i));
+        latencies[i] = timer.elapsedNanoseconds();
+    }
+    double seconds = total.elapsedSeconds();
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double q) {
+        return static_cast<long long>(latencies[static_cast<std::size_t>(q * static_cast<double>(kPushes - 1))]);
+    };
+    report(name, kPushes, seconds);
+    std::printf("%-48s p50 %6lld ns  p99.99 %8lld ns  max %10lld ns\n", "", percentile(0.5), percentile(0.9999),
+                static_cast<long long>(latencies.back()));
+}
+
+// Pushes and pops around a chunk boundary
+void benchBoundary() {
+    SegmentedStack<int> stack;
+    while (stack.getSize() < 1024) {
+        stack.push(0);
+    }
+    std::size_t allocations = allocation_counter::allocations;
+    Timer timer;
+    for (std::size_t i = 0; i < kBoundaryRounds; ++i) {
+        stack.push(static_cast<int>(i));
+        stack.pop();
+        stack.pop();
+        stack.push(static_cast<int>(i));
+    }
+    report("SegmentedStack<int> push/pop at chunk boundary", kBoundaryRounds * 4, timer.elapsedSeconds());
+    std::printf("%-48s %12zu allocations\n", "", allocation_counter::allocations - allocations);
+}
+
+} // namespace
+
+int main() {
+    benchPushLatency<Stack<int>>("Stack<int> push");
+    benchPushLatency<SegmentedStack<int>>("SegmentedStack<int> push");
+    benchBoundary();
+    return 0;
+}
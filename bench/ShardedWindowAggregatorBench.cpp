@@ -0,0 +1,98 @@
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../MinMaxQueue/ShardedWindowAggregator/ShardedWindowAggregator.h"
+#include "Bench.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kPushesPerThread = 1 << 21;
+constexpr std::size_t kWindowElements = 1 << 16;
+// Time window of 10 ms in buckets of 1 ms
+constexpr std::int64_t kBucketWidth = 1000000;
+constexpr std::int64_t kWindowNanoseconds = 10 * kBucketWidth;
+
+[[nodiscard]] std::int64_t now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Producers push, one reader thread queries the window until the producers finish
+template <typename Push, typename Read>
+void runThreads(const std::string &name, std::size_t threads_count, Push push, Read read) {
+    std::atomic<bool> done{false};
+    std::thread reader([&done, &read]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            read();
+            std::this_thread::yield();
+        }
+    });
+    Timer timer;
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < threads_count; ++t) {
+        producers.emplace_back([t, &push]() {
+            Random random(t + 1);
+            for (std::size_t i = 0; i < kPushesPerThread; ++i) {
+                push(static_cast<long long>(random.next(1000000)));
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    double seconds = timer.elapsedSeconds();
+    done.store(true, std::memory_order_relaxed);
+    reader.join();
+    report((name + " threads " + std::to_string(threads_count)).c_str(), kPushesPerThread * threads_count,
+           seconds);
+}
+
+void benchLockedQueue(std::size_t threads_count) {
+    std::mutex mutex;
+    Queue<BasicMinMaxNode<long long>> window(kWindowElements + 1);
+    runThreads(
+        "mutex + Queue<MinMaxNode> push", threads_count,
+        [&mutex, &window](long long value) {
+            std::int64_t timestamp = now();
+            doNotOptimize(timestamp);
+            std::lock_guard<std::mutex> lock(mutex);
+            window.push(value);
+            if (window.getSize() > kWindowElements) {
+                window.pop();
+            }
+        },
+        [&mutex, &window]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!window.empty()) {
+                doNotOptimize(window.getMaxDiff());
+            }
+        });
+}
+
+void benchSharded(std::size_t threads_count) {
+    ShardedWindowAggregator<MinMax<long long>, MinMaxMonoid<long long>> window(kBucketWidth, threads_count);
+    runThreads(
+        "ShardedWindowAggregator push", threads_count,
+        [&window](long long value) { window.push(now(), MinMax<long long>{value, value}); },
+        [&window]() {
+            window.evictBefore(now() - kWindowNanoseconds);
+            doNotOptimize(window.query());
+        });
+}
+
+} // namespace
+
+int main() {
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 4) {
+        max_threads = 4;
+    }
+    for (std::size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+        benchLockedQueue(threads_count);
+        benchSharded(threads_count);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../MinMaxQueue/SlidingWindowAggregator/SlidingWindowAggregator.h"
+#include "Bench.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 22;
+constexpr std::size_t kWindow = 1 << 10;
+
+template <typename T, typename Monoid, typename Generator>
+void benchAggregator(const char *name, Generator generate) {
+    SlidingWindowAggregator<T, Monoid> window(kWindow);
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kElements; ++i) {
+        window.push(generate(random, i));
+        if (window.getSize() > kWindow) {
+            window.pop();
+        }
+        doNotOptimize(window.query());
+    }
+    report(name, kElements, timer.elapsedSeconds());
+}
+
+void benchMinMaxQueue() {
+    Queue<MinMaxNode> window(kWindow);
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kElements; ++i) {
+        window.push(static_cast<int>(random.next(1000000)));
+        if (window.getSize() > kWindow) {
+            window.pop();
+        }
+        doNotOptimize(window.getMaxDiff());
+    }
+    report("Queue<MinMaxNode> getMaxDiff", kElements, timer.elapsedSeconds());
+}
+
+} // namespace
+
+int main() {
+    auto random_int = [](Random &random, std::size_t) { return static_cast<int>(random.next(1000000)); };
+    auto random_double = [](Random &random, std::size_t) {
+        return static_cast<double>(random.next(1000000)) / 1000.0;
+    };
+    benchMinMaxQueue();
+    benchAggregator<int, SumMonoid<int>>("int sum", random_int);
+    benchAggregator<int, MinMonoid<int>>("int min", random_int);
+    benchAggregator<int, GcdMonoid<int>>("int gcd", random_int);
+    benchAggregator<double, SumMonoid<double>>("double sum", random_double);
+    benchAggregator<double, MaxMonoid<double>>("double max", random_double);
+    benchAggregator<MinMax<int>, MinMaxMonoid<int>>("MinMax<int> min and max", [](Random &random, std::size_t) {
+        int value = static_cast<int>(random.next(1000000));
+        return MinMax<int>{value, value};
+    });
+    benchAggregator<IndexedValue<double>, ArgMaxMonoid<double>>(
+        "IndexedValue<double> argmax", [random_double](Random &random, std::size_t index) {
+            return IndexedValue<double>{random_double(random, index), index};
+        });
+    benchAggregator<Histogram<16>, HistogramMonoid<16>>("Histogram<16> merge", [](Random &random, std::size_t) {
+        Histogram<16> histogram{};
+        ++histogram.counts[random.next(16)];
+        return histogram;
+    });
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <string>
+
+namespace {
+
+constexpr std::size_t kStacks = 1 << 20;
+
+// Every short-lived stack is constructed, gets depth pushes, is drained and destroyed
+template <std::size_t InlineCapacity>
+void benchShortLived(std::size_t depth) {
+    std::size_t allocations = allocation_counter::allocations;
+    Timer timer;
+    for (std::size_t i = 0; i < kStacks; ++i) {
+        Stack<int, InlineCapacity> stack;
+        for (std::size_t j = 0; j < depth; ++j) {
+            stack.push(static_cast<int>(i + j));
+        }
+        while (!stack.empty()) {
+            doNotOptimize(stack.top());
+            stack.pop();
+        }
+    }
+    double seconds = timer.elapsedSeconds();
+    allocations = allocation_counter::allocations - allocations;
+    std::string name =
+        "Stack<int, " + std::to_string(InlineCapacity) + "> depth " + std::to_string(depth);
+    report(name.c_str(), kStacks, seconds);
+    std::printf("%-48s %12.3f allocations/stack %8zu bytes/object\n", "", static_cast<double>(allocations) / kStacks,
+                sizeof(Stack<int, InlineCapacity>));
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t depth : {0UL, 4UL, 16UL, 64UL}) {
+        benchShortLived<0>(depth);
+        benchShortLived<8>(depth);
+        benchShortLived<32>(depth);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../MinMaxQueue/SplitQueue/SplitQueue.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOperations = 1 << 24;
+constexpr std::size_t kWindows = 1 << 16;
+constexpr std::size_t kSmallWindowSize = 8;
+
+// One sliding window: push, evict the oldest value and ask for max - min
+template <typename Window>
+void benchWindow(const char *name, std::size_t window_size) {
+    Window window(window_size + 1);
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        window.push(static_cast<int>(random.next(1000000)));
+        if (window.getSize() > window_size) {
+            window.pop();
+        }
+        doNotOptimize(window.getMaxDiff());
+    }
+    report((std::string(name) + " window " + std::to_string(window_size)).c_str(), kOperations,
+           timer.elapsedSeconds());
+}
+
+// Many small windows touched in random order, so most operations miss the cache
+template <typename Window>
+void benchManyWindows(const char *name) {
+    std::size_t allocations_before = allocation_counter::allocations;
+    std::size_t bytes_before = allocation_counter::live_bytes;
+    std::vector<Window> windows;
+    windows.reserve(kWindows);
+    for (std::size_t i = 0; i < kWindows; ++i) {
+        windows.emplace_back(kSmallWindowSize + 1);
+    }
+    Random random;
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        Window &window = windows[random.next(kWindows)];
+        window.push(static_cast<int>(random.next(1000000)));
+        if (window.getSize() > kSmallWindowSize) {
+            window.pop();
+        }
+        doNotOptimize(window.getMaxDiff());
+    }
+    double seconds = timer.elapsedSeconds();
+    report((std::string(name) + " x" + std::to_string(kWindows) + " window " + std::to_string(kSmallWindowSize))
+               .c_str(),
+           kOperations, seconds);
+    std::printf("%-48s %10.2f allocations/window %8.1f bytes/window\n", "",
+                static_cast<double>(allocation_counter::allocations - allocations_before - 1) / kWindows,
+                static_cast<double>(allocation_counter::live_bytes - bytes_before) / kWindows);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t window_size : {16UL, 1024UL, 65536UL}) {
+        benchWindow<Queue<MinMaxNode>>("Queue<MinMaxNode>", window_size);
+        benchWindow<SplitQueue<MinMaxNode>>("SplitQueue<MinMaxNode>", window_size);
+    }
+    benchManyWindows<Queue<MinMaxNode>>("Queue<MinMaxNode>");
+    benchManyWindows<SplitQueue<MinMaxNode>>("SplitQueue<MinMaxNode>");
+    return 0;
+}
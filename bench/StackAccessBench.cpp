@@ -0,0 +1,76 @@
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "Bench.h"
+#include <string>
+
+namespace {
+
+constexpr std::size_t kOperations = 1 << 24;
+constexpr std::size_t kDepth = 64;
+
+// Parser-like inner loop: push an operand, combine the two topmost operands, unwind every kDepth steps
+void benchChecked() {
+    Stack<long long> stack(kDepth + 1);
+    stack.push(0);
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        stack.push(static_cast<long long>(i));
+        if (stack.getSize() > kDepth) {
+            while (stack.getSize() > 1) {
+                long long right = stack.top();
+                stack.pop();
+                stack.top() += right;
+            }
+        }
+    }
+    doNotOptimize(stack.top());
+    report("Stack<long long> checked push/top/pop", kOperations, timer.elapsedSeconds());
+}
+
+void benchUnchecked() {
+    Stack<long long> stack(kDepth + 1);
+    stack.push(0);
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        stack.pushUnchecked(static_cast<long long>(i));
+        if (stack.getSize() > kDepth) {
+            while (stack.getSize() > 1) {
+                long long right = stack.topUnchecked();
+                stack.popUnchecked();
+                stack.topUnchecked() += right;
+            }
+        }
+    }
+    doNotOptimize(stack.topUnchecked());
+    report("Stack<long long> unchecked push/top/pop", kOperations, timer.elapsedSeconds());
+}
+
+// Strings too long for the small string buffer, push of a temporary moves it, emplace builds in place
+template <bool Emplace>
+void benchStrings(const char *name) {
+    Stack<std::string> stack(kDepth);
+    Timer timer;
+    for (std::size_t i = 0; i < kOperations / kDepth; ++i) {
+        for (std::size_t j = 0; j < kDepth; ++j) {
+            if constexpr (Emplace) {
+                stack.emplace(32, static_cast<char>('a' + j % 26));
+            } else {
+                stack.push(std::string(32, static_cast<char>('a' + j % 26)));
+            }
+        }
+        while (!stack.empty()) {
+            doNotOptimize(stack.top().size());
+            stack.pop();
+        }
+    }
+    report(name, kOperations / kDepth * kDepth, timer.elapsedSeconds());
+}
+
+} // namespace
+
+int main() {
+    benchChecked();
+    benchUnchecked();
+    benchStrings<false>("Stack<std::string> push(std::string&&)");
+    benchStrings<true>("Stack<std::string> emplace");
+    return 0;
+}
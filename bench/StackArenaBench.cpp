@@ -0,0 +1,78 @@
+// Build: g++ -std=c++17 -O2 StackArenaBench.cpp ../Heap/Heap/Heap.cpp ../Heap/Compare/Compare.cpp
+#include "../Heap/Heap/Heap.h"
+#include "../Map/Map.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../StackArena/StackArena.h"
+#include "AllocationCounter.h"
+#include "Bench.h"
+#include <functional>
+#include <string>
+
+namespace {
+
+// Every configuration handles the same number of elements in total
+constexpr std::size_t kElements = 1 << 20;
+
+// One request handler: builds an index, a priority queue, a sliding window and a scratch stack,
+// answers from them and drops them all
+std::int64_t handleRequest(std::size_t request, std::size_t elements, std::pmr::memory_resource *resource) {
+    Random random(request + 1);
+    Map<int, int, std::less<int>> index(resource);
+    Heap<int, MoreCompare<int>> heap(0, resource);
+    Queue<MinMaxNode> window(16, resource);
+    Stack<int> scratch(16, resource);
+    std::int64_t answer = 0;
+    for (std::size_t i = 0; i < elements; ++i) {
+        int value = static_cast<int>(random.next(1000000));
+        index.insert({value, static_cast<int>(i)});
+        heap.push(value);
+        window.push(value);
+        if (window.getSize() > 16) {
+            window.pop();
+        }
+        scratch.push(value);
+        answer += window.getMaxDiff();
+    }
+    while (!heap.empty()) {
+        answer += heap.top();
+        heap.pop();
+    }
+    return answer + static_cast<std::int64_t>(index.getSize() + scratch.getSize());
+}
+
+void benchRequests(std::size_t elements) {
+    std::size_t requests = kElements / elements;
+    std::size_t allocations = allocation_counter::allocations;
+    Timer timer;
+    for (std::size_t request = 0; request < requests; ++request) {
+        doNotOptimize(handleRequest(request, elements, std::pmr::get_default_resource()));
+    }
+    double seconds = timer.elapsedSeconds();
+    std::string name = "default resource, " + std::to_string(elements) + " elements/request";
+    report(name.c_str(), requests, seconds);
+    std::printf("%-48s %12.2f allocations/request\n", "",
+                static_cast<double>(allocation_counter::allocations - allocations) / requests);
+
+    StackArena arena;
+    allocations = allocation_counter::allocations;
+    timer.reset();
+    for (std::size_t request = 0; request < requests; ++request) {
+        StackArena::Mark mark = arena.mark();
+        doNotOptimize(handleRequest(request, elements, &arena));
+        arena.rewind(mark);
+    }
+    seconds = timer.elapsedSeconds();
+    name = "StackArena with rewind, " + std::to_string(elements) + " elements/request";
+    report(name.c_str(), requests, seconds);
+    std::printf("%-48s %12.2f allocations/request\n", "",
+                static_cast<double>(allocation_counter::allocations - allocations) / requests);
+}
+
+} // namespace
+
+int main() {
+    for (std::size_t elements : {16UL, 256UL, 4096UL}) {
+        benchRequests(elements);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Stack against std::vector and std::stack (std::deque) for several payload sizes
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "Suite.h"
+#include "Workload.h"
+#include <stack>
+#include <vector>
+
+using namespace suite;
+
+namespace {
+
+// Fills the container to size, then empties it
+template <typename T>
+void benchPushPop(Results &results, std::size_t size) {
+    results.measure("Stack", "push/pop", sizeof(T), size, [size] {
+        Stack<T> stack;
+        for (std::size_t i = 0; i < size; ++i) {
+            stack.push(makeValue<T>(i));
+        }
+        while (!stack.empty()) {
+            doNotOptimize(stack.topUnchecked());
+            stack.popUnchecked();
+        }
+        return 2 * size;
+    });
+    results.measure("std::vector", "push/pop", sizeof(T), size, [size] {
+        std::vector<T> vector;
+        for (std::size_t i = 0; i < size; ++i) {
+            vector.push_back(makeValue<T>(i));
+        }
+        while (!vector.empty()) {
+            doNotOptimize(vector.back());
+            vector.pop_back();
+        }
+        return 2 * size;
+    });
+    results.measure("std::stack", "push/pop", sizeof(T), size, [size] {
+        std::stack<T> stack;
+        for (std::size_t i = 0; i < size; ++i) {
+            stack.push(makeValue<T>(i));
+        }
+        while (!stack.empty()) {
+            doNotOptimize(stack.top());
+            stack.pop();
+        }
+        return 2 * size;
+    });
+}
+
+// Random pushes and pops around size elements, the stack never shrinks below its start
+template <typename T>
+void benchMixed(Results &results, std::size_t size) {
+    {
+        Stack<T> stack;
+        for (std::size_t i = 0; i < size; ++i) {
+            stack.push(makeValue<T>(i));
+        }
+        workload::OperationMix mix({1, 1});
+        results.measure("Stack", "mixed", sizeof(T), size, [size, &stack, &mix] {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (mix.next() == 0 || stack.getSize() <= size) {
+                    stack.push(makeValue<T>(i));
+                } else {
+                    doNotOptimize(stack.topUnchecked());
+                    stack.popUnchecked();
+                }
+            }
+            return size;
+        });
+    }
+    std::vector<T> vector;
+    for (std::size_t i = 0; i < size; ++i) {
+        vector.push_back(makeValue<T>(i));
+    }
+    workload::OperationMix mix({1, 1});
+    results.measure("std::vector", "mixed", sizeof(T), size, [size, &vector, &mix] {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (mix.next() == 0 || vector.size() <= size) {
+                vector.push_back(makeValue<T>(i));
+            } else {
+                doNotOptimize(vector.back());
+                vector.pop_back();
+            }
+        }
+        return size;
+    });
+}
+
+template <typename T>
+void benchPayload(Results &results) {
+    for (std::size_t size : results.sizes()) {
+        // The array doubles, so a copy of the old one lives next to the new one while it grows
+        if (!results.fits(size, 3 * sizeof(T))) {
+            break;
+        }
+        benchPushPop<T>(results, size);
+        benchMixed<T>(results, size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Results results("StackBench", parseOptions(argc, argv));
+    benchPayload<int>(results);
+    benchPayload<Payload<32>>(results);
+    benchPayload<Payload<256>>(results);
+    return results.finish();
+}
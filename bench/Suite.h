@@ -0,0 +1,244 @@
+#ifndef CUSTOM_DS_BENCH_SUITE
+#define CUSTOM_DS_BENCH_SUITE
+#include "Bench.h"
+#include "PerfCounters.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Shared part of the container benchmarks: payload types, the size sweep and JSON results with
+// hardware counters per operation where the machine has them
+// Every container benchmark accepts
+//   --max-size N     sizes go 10, 100, ... up to N, 10^8 by default
+//   --max-memory MB  skips sizes whose elements would take more memory, 1024 by default
+//   --json PATH      also writes the results as JSON, - for stdout, which moves the report to stderr
+namespace suite {
+
+// Element of Bytes bytes ordered by its key, the padding is what a bigger payload costs to move
+template <std::size_t Bytes>
+struct Payload {
+    static_assert(Bytes > sizeof(std::uint64_t), "Small payloads are plain integers");
+
+    std::uint64_t key;
+    unsigned char padding[Bytes - sizeof(std::uint64_t)];
+
+    Payload() noexcept : key(0), padding() {}
+
+    explicit Payload(std::uint64_t key) noexcept : key(key), padding() {}
+
+    [[nodiscard]] bool operator<(const Payload &right) const noexcept { return key < right.key; }
+
+    [[nodiscard]] bool operator>(const Payload &right) const noexcept { return key > right.key; }
+
+    [[nodiscard]] bool operator==(const Payload &right) const noexcept { return key == right.key; }
+};
+
+template <typename T>
+[[nodiscard]] T makeValue(std::uint64_t key) noexcept {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<T>(key);
+    } else {
+        return T(key);
+    }
+}
+
+template <typename T>
+[[nodiscard]] std::uint64_t keyOf(const T &value) noexcept {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<std::uint64_t>(value);
+    } else {
+        return value.key;
+    }
+}
+
+// Inline comparator for payloads, Heap<int, MoreCompare<int>> keeps its own out-of-line one
+template <typename T>
+struct Greater {
+    [[nodiscard]] bool operator()(const T &left, const T &right) const noexcept { return left > right; }
+};
+
+struct Options {
+    std::size_t max_size = 100000000;
+    std::size_t max_memory_bytes = std::size_t(1024) << 20;
+    const char *json_path = nullptr;
+};
+
+[[nodiscard]] inline Options parseOptions(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (has_value && std::strcmp(argv[i], "--max-size") == 0) {
+            options.max_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (has_value && std::strcmp(argv[i], "--max-memory") == 0) {
+            options.max_memory_bytes = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10)) << 20;
+        } else if (has_value && std::strcmp(argv[i], "--json") == 0) {
+            options.json_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--max-size N] [--max-memory MB] [--json PATH]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+// A small size is repeated until it runs this many elements, so its timing isn't just noise
+constexpr std::size_t kMinElements = 1 << 20;
+
+[[nodiscard]] inline std::size_t repetitions(std::size_t size) noexcept {
+    return size >= kMinElements ? 1 : kMinElements / size;
+}
+
+class Results {
+private:
+    struct Record {
+        std::string container;
+        std::string workload;
+        std::size_t payload_bytes;
+        std::size_t size;
+        std::size_t operations;
+        double seconds;
+        // Per operation
+        double counters[PerfCounters::kEventsCount];
+    };
+
+    std::string benchmark;
+    Options options;
+    std::vector<Record> records;
+    PerfCounters counters;
+    // The human-readable report, kept off stdout when the JSON goes there
+    std::FILE *log;
+
+    static void writeString(std::FILE *file, const std::string &text) {
+        std::fputc('"', file);
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', file);
+            }
+            std::fputc(c, file);
+        }
+        std::fputc('"', file);
+    }
+
+    // Takes the counters since their last reset
+    void add(const std::string &container, const std::string &workload, std::size_t payload_bytes,
+             std::size_t size, std::size_t operations, double seconds) {
+        std::string name = container + " " + workload + " " + std::to_string(payload_bytes) + "B n=" +
+                           std::to_string(size);
+        report(log, name.c_str(), operations, seconds);
+        Record record{container, workload, payload_bytes, size, operations, seconds, {}};
+        if (counters.anyAvailable() && operations > 0) {
+            std::fprintf(log, "%-48s", "");
+            for (int event = 0; event < PerfCounters::kEventsCount; ++event) {
+                record.counters[event] = counters.count(event) / static_cast<double>(operations);
+                if (counters.available(event)) {
+                    std::fprintf(log, " %s %.2f", PerfCounters::name(event), record.counters[event]);
+                }
+            }
+            std::fprintf(log, " per op\n");
+        }
+        records.push_back(record);
+    }
+
+public:
+    Results(const char *benchmark, const Options &options)
+        : benchmark(benchmark), options(options),
+          log(options.json_path != nullptr && std::strcmp(options.json_path, "-") == 0 ? stderr : stdout) {}
+
+    // 10, 100, ... up to the largest size
+    [[nodiscard]] std::vector<std::size_t> sizes() const {
+        std::vector<std::size_t> result;
+        for (std::size_t size = 10; size <= options.max_size; size *= 10) {
+            result.push_back(size);
+        }
+        return result;
+    }
+
+    // bytes_per_element estimates the peak footprint, including growth slack and node overhead
+    [[nodiscard]] bool fits(std::size_t size, std::size_t bytes_per_element) const noexcept {
+        return size <= options.max_memory_bytes / bytes_per_element;
+    }
+
+    // Times run() repetitions(size) times, run returns the number of operations it did
+    template <typename Run>
+    void measure(const std::string &container, const std::string &workload, std::size_t payload_bytes,
+                 std::size_t size, Run run) {
+        std::size_t operations = 0;
+        counters.reset();
+        Timer timer;
+        counters.start();
+        for (std::size_t i = repetitions(size); i > 0; --i) {
+            operations += run();
+        }
+        counters.stop();
+        add(container, workload, payload_bytes, size, operations, timer.elapsedSeconds());
+    }
+
+    // Same, but every repetition first builds its input with setup(), which isn't measured
+    template <typename Setup, typename Run>
+    void measure(const std::string &container, const std::string &workload, std::size_t payload_bytes,
+                 std::size_t size, Setup setup, Run run) {
+        std::size_t operations = 0;
+        double seconds = 0;
+        counters.reset();
+        for (std::size_t i = repetitions(size); i > 0; --i) {
+            auto input = setup();
+            Timer timer;
+            counters.start();
+            operations += run(input);
+            counters.stop();
+            seconds += timer.elapsedSeconds();
+        }
+        add(container, workload, payload_bytes, size, operations, seconds);
+    }
+
+    // Writes the JSON file if one was asked for, returns the exit code
+    [[nodiscard]] int finish() const {
+        if (options.json_path == nullptr) {
+            return 0;
+        }
+        bool to_stdout = std::strcmp(options.json_path, "-") == 0;
+        std::FILE *file = to_stdout ? stdout : std::fopen(options.json_path, "w");
+        if (file == nullptr) {
+            std::fprintf(stderr, "Can't open %s\n", options.json_path);
+            return 1;
+        }
+        std::fprintf(file, "{\n  \"benchmark\": ");
+        writeString(file, benchmark);
+        std::fprintf(file, ",\n  \"results\": [");
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const Record &record = records[i];
+            std::fprintf(file, "%s\n    {\"container\": ", i == 0 ? "" : ",");
+            writeString(file, record.container);
+            std::fprintf(file, ", \"workload\": ");
+            writeString(file, record.workload);
+            double nanoseconds = record.operations == 0 ? 0.0 : record.seconds * 1e9 / record.operations;
+            std::fprintf(file,
+                         ", \"payload_bytes\": %zu, \"size\": %zu, \"operations\": %zu, \"seconds\": %.9g, "
+                         "\"ns_per_op\": %.6g",
+                         record.payload_bytes, record.size, record.operations, record.seconds, nanoseconds);
+            // Only the events this machine counts
+            std::fprintf(file, ", \"counters_per_op\": {");
+            const char *separator = "";
+            for (int event = 0; event < PerfCounters::kEventsCount; ++event) {
+                if (counters.available(event)) {
+                    std::fprintf(file, "%s\"%s\": %.6g", separator, PerfCounters::name(event),
+                                 record.counters[event]);
+                    separator = ", ";
+                }
+            }
+            std::fprintf(file, "}}");
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+        if (!to_stdout && std::fclose(file) != 0) {
+            std::fprintf(stderr, "Can't write %s\n", options.json_path);
+            return 1;
+        }
+        return 0;
+    }
+};
+
+} // namespace suite
+
+#endif // CUSTOM_DS_BENCH_SUITE
@@ -0,0 +1,179 @@
+// Randomized check of TimeWindowAggregator against a naive deque of (timestamp, value) events
+// Covers evictBefore at and around bucket boundaries, the open bucket alone in the window, negative
+// timestamps, timestamps at both ends of the range and the exception on a timestamp older than the open bucket
+// Exit code 1 on a mismatch
+#include "../MinMaxQueue/Monoid/Monoid.h"
+#include "../MinMaxQueue/TimeWindowAggregator/TimeWindowAggregator.h"
+#include "Bench.h"
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using Aggregator = TimeWindowAggregator<std::int64_t, SumMonoid<std::int64_t>>;
+
+bool failed = false;
+
+// Every event of the window, evicted a whole bucket at a time
+class NaiveWindow {
+private:
+    std::deque<std::pair<std::int64_t, std::int64_t>> events;
+    std::int64_t bucket_width;
+
+public:
+    explicit NaiveWindow(std::int64_t bucket_width) : bucket_width(bucket_width) {}
+
+    [[nodiscard]] std::int64_t bucketStart(std::int64_t timestamp) const {
+        std::int64_t remainder = timestamp % bucket_width;
+        return timestamp - (remainder < 0 ? remainder + bucket_width : remainder);
+    }
+
+    [[nodiscard]] bool empty() const { return events.empty(); }
+
+    [[nodiscard]] std::int64_t newestTimestamp() const { return events.back().first; }
+
+    [[nodiscard]] std::int64_t oldestBucket() const { return bucketStart(events.front().first); }
+
+    [[nodiscard]] std::size_t buckets() const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            if (i == 0 || bucketStart(events[i].first) != bucketStart(events[i - 1].first)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    [[nodiscard]] std::int64_t sum() const {
+        std::int64_t result = 0;
+        for (const auto &event : events) {
+            result += event.second;
+        }
+        return result;
+    }
+
+    void push(std::int64_t timestamp, std::int64_t value) { events.emplace_back(timestamp, value); }
+
+    void evictBefore(std::int64_t timestamp) {
+        while (!events.empty() && bucketStart(events.front().first) + bucket_width <= timestamp) {
+            events.pop_front();
+        }
+    }
+};
+
+void check(bool condition, const char *what, std::int64_t bucket_width, std::size_t operation) {
+    if (!condition) {
+        std::printf("    check failed: %s (bucket width %lld, operation %zu)\n", what,
+                    static_cast<long long>(bucket_width), operation);
+        failed = true;
+    }
+}
+
+void compare(const Aggregator &window, const NaiveWindow &naive, std::int64_t bucket_width, std::size_t operation) {
+    check(window.empty() == naive.empty(), "empty() differs", bucket_width, operation);
+    check(window.query() == naive.sum(), "query() differs", bucket_width, operation);
+    check(window.getSize() == naive.buckets(), "getSize() differs", bucket_width, operation);
+    if (!naive.empty()) {
+        check(window.oldestTimestamp() == naive.oldestBucket(), "oldestTimestamp() differs", bucket_width,
+              operation);
+    }
+}
+
+void run(std::int64_t bucket_width, std::size_t operations, std::uint64_t seed) {
+    Random random(seed);
+    // Capacity 1 makes the closed buckets grow and wrap around in the sliding window
+    Aggregator window(bucket_width, 1);
+    NaiveWindow naive(bucket_width);
+    std::int64_t now = -static_cast<std::int64_t>(random.next(1000));
+    std::size_t rejected = 0;
+    for (std::size_t operation = 0; operation < operations; ++operation) {
+        std::uint64_t choice = random.next(16);
+        if (choice < 9) {
+            // Same timestamp, same bucket or a few buckets later
+            now += static_cast<std::int64_t>(random.next(static_cast<std::uint64_t>(3 * bucket_width)));
+            std::int64_t value = static_cast<std::int64_t>(random.next(2000)) - 1000;
+            window.push(now, value);
+            naive.push(now, value);
+        } else if (choice < 13) {
+            // A bucket boundary, or one off it, somewhere in or just past the window
+            std::int64_t base = naive.empty() ? now : naive.oldestBucket();
+            std::int64_t span = now - base + 2 * bucket_width;
+            std::int64_t boundary = naive.bucketStart(base + static_cast<std::int64_t>(random.next(
+                                                                 static_cast<std::uint64_t>(span))));
+            std::int64_t timestamp = boundary + static_cast<std::int64_t>(random.next(3)) - 1;
+            window.evictBefore(timestamp);
+            naive.evictBefore(timestamp);
+        } else if (choice < 14) {
+            // Evict every closed bucket, so only the open one is left
+            if (!naive.empty()) {
+                std::int64_t open_start = naive.bucketStart(naive.newestTimestamp());
+                window.evictBefore(open_start);
+                naive.evictBefore(open_start);
+                check(window.getSize() == 1, "evicting the closed buckets left more than the open one",
+                      bucket_width, operation);
+            }
+        } else if (!naive.empty()) {
+            // A timestamp of an older bucket than the open one is rejected and changes nothing
+            std::int64_t open_start = naive.bucketStart(naive.newestTimestamp());
+            std::int64_t older = open_start - 1 - static_cast<std::int64_t>(random.next(
+                                                      static_cast<std::uint64_t>(2 * bucket_width)));
+            bool thrown = false;
+            try {
+                window.push(older, 1);
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+                ++rejected;
+            }
+            check(thrown, "a decreasing timestamp was accepted", bucket_width, operation);
+        }
+        compare(window, naive, bucket_width, operation);
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "TimeWindowAggregator bucket width %lld", static_cast<long long>(bucket_width));
+    std::printf("%-48s %8zu operations %6zu rejected\n", name, operations, rejected);
+}
+
+// Buckets at both ends of the range, where start + bucket_width or a distance between timestamps overflows
+void extremes() {
+    constexpr std::int64_t kWidth = 100;
+    // The smallest bucket start, the bucket of any smaller timestamp starts out of range
+    constexpr std::int64_t kLowest = std::numeric_limits<std::int64_t>::min() -
+                                     std::numeric_limits<std::int64_t>::min() % kWidth;
+    constexpr std::int64_t kMax = std::numeric_limits<std::int64_t>::max();
+    Aggregator window(kWidth);
+    window.push(kLowest, 1);
+    window.evictBefore(kLowest + kWidth - 1);
+    check(window.getSize() == 1, "the bucket at the smallest timestamp was evicted early", kWidth, 0);
+    window.push(kMax - kWidth, 2);
+    window.push(kMax, 3);
+    check(window.query() == 6, "query() at the largest timestamp differs", kWidth, 1);
+    // Further from the smallest bucket than Timestamp holds
+    window.evictBefore(kMax);
+    check(window.getSize() == 1 && window.query() == 3, "evicting at the largest timestamp differs", kWidth, 2);
+    check(window.oldestTimestamp() == kMax - kMax % kWidth, "oldestTimestamp() at the largest timestamp differs",
+          kWidth, 3);
+    window.evictBefore(kLowest);
+    check(window.getSize() == 1, "evicting at the smallest timestamp dropped a bucket", kWidth, 4);
+    std::printf("%-48s %8d operations\n", "TimeWindowAggregator range ends", 5);
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kOperations = 200000;
+    std::uint64_t seed = 1;
+    for (std::int64_t bucket_width : {1, 2, 7, 100}) {
+        run(bucket_width, kOperations, seed++);
+    }
+    extremes();
+    bool thrown = false;
+    try {
+        Aggregator window(0);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "bucket width 0 was accepted", 0, 0);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+#ifndef CUSTOM_DS_TRACE
+#define CUSTOM_DS_TRACE
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Binary trace of Map, Heap and Queue operations, recorded from a real program and replayed
+// against other containers by TraceReplay
+// A trace is the magic "CDSTRACE", a version byte and then one record per operation: an operation
+// byte followed, for operations with a key, by the key as a LEB128 varint (7 bits per byte, low
+// bits first), so a pop takes 1 byte and a small key 2 or 3
+namespace trace {
+
+enum class Operation : std::uint8_t {
+    kMapInsert = 1,
+    kMapFind,
+    kMapErase,
+    kHeapPush,
+    kHeapPop,
+    kQueuePush,
+    kQueuePop,
+};
+
+constexpr char kMagic[8] = {'C', 'D', 'S', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint8_t kVersion = 1;
+
+[[nodiscard]] inline bool hasKey(Operation operation) noexcept {
+    return operation != Operation::kHeapPop && operation != Operation::kQueuePop;
+}
+
+struct Record {
+    Operation operation;
+    std::uint64_t key;
+};
+
+class Writer {
+private:
+    std::FILE *file;
+
+    void put(int byte) {
+        if (file == nullptr) {
+            throw std::logic_error("The trace is closed");
+        }
+        if (std::fputc(byte, file) == EOF) {
+            throw std::runtime_error("Can't write the trace");
+        }
+    }
+
+public:
+    explicit Writer(const std::string &path) : file(std::fopen(path.c_str(), "wb")) {
+        if (file == nullptr) {
+            throw std::runtime_error("Can't open " + path);
+        }
+        if (std::fwrite(kMagic, 1, sizeof(kMagic), file) != sizeof(kMagic) || std::fputc(kVersion, file) == EOF) {
+            std::fclose(file);
+            throw std::runtime_error("Can't write the trace");
+        }
+    }
+
+    Writer(const Writer &other) = delete;
+
+    Writer &operator=(const Writer &other) = delete;
+
+    // Only a fallback for a trace that wasn't closed, a failed flush here goes unnoticed
+    ~Writer() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    // Flushes and closes the trace, throws if the buffered records can't be written (a full disk),
+    // so a truncated trace is never taken for a complete one
+    void close() {
+        if (file == nullptr) {
+            return;
+        }
+        std::FILE *closed_file = file;
+        file = nullptr;
+        if (std::fclose(closed_file) != 0) {
+            throw std::runtime_error("Can't write the trace");
+        }
+    }
+
+    void record(Operation operation, std::uint64_t key = 0) {
+        put(static_cast<std::uint8_t>(operation));
+        if (hasKey(operation)) {
+            while (key >= 0x80) {
+                put(static_cast<int>(key & 0x7F) | 0x80);
+                key >>= 7;
+            }
+            put(static_cast<int>(key));
+        }
+    }
+};
+
+// Decodes the whole trace up front, so a replay doesn't time the decoding
+[[nodiscard]] inline std::vector<Record> read(const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Can't open " + path);
+    }
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[1 << 16];
+    std::size_t read_bytes = 0;
+    while ((read_bytes = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read_bytes);
+    }
+    std::fclose(file);
+    if (bytes.size() < sizeof(kMagic) + 1 || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(path + " is not a trace");
+    }
+    if (bytes[sizeof(kMagic)] != kVersion) {
+        throw std::runtime_error(path + " has an unknown trace version");
+    }
+    std::vector<Record> records;
+    std::size_t position = sizeof(kMagic) + 1;
+    while (position < bytes.size()) {
+        std::uint8_t operation = bytes[position++];
+        if (operation < static_cast<std::uint8_t>(Operation::kMapInsert) ||
+            operation > static_cast<std::uint8_t>(Operation::kQueuePop)) {
+            throw std::runtime_error(path + " has an unknown operation");
+        }
+        Record record{static_cast<Operation>(operation), 0};
+        if (hasKey(record.operation)) {
+            unsigned int shift = 0;
+            std::uint8_t byte = 0x80;
+            while ((byte & 0x80) != 0) {
+                if (position == bytes.size() || shift > 63) {
+                    throw std::runtime_error(path + " is truncated");
+                }
+                byte = bytes[position++];
+                record.key |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                shift += 7;
+            }
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+// Wrappers that forward to a container and record what was done to it, keys are std::uint64_t
+// Map operations
+template <typename M>
+class RecordingMap {
+private:
+    M &map;
+    Writer &writer;
+
+public:
+    RecordingMap(M &map, Writer &writer) noexcept : map(map), writer(writer) {}
+
+    template <typename Value>
+    auto insert(std::uint64_t key, Value &&value) {
+        writer.record(Operation::kMapInsert, key);
+        return map.insert({key, std::forward<Value>(value)});
+    }
+
+    auto find(std::uint64_t key) {
+        writer.record(Operation::kMapFind, key);
+        return map.find(key);
+    }
+
+    void erase(std::uint64_t key) {
+        writer.record(Operation::kMapErase, key);
+        map.erase(key);
+    }
+};
+
+// Heap operations on std::uint64_t values, top isn't recorded
+template <typename H>
+class RecordingHeap {
+private:
+    H &heap;
+    Writer &writer;
+
+public:
+    RecordingHeap(H &heap, Writer &writer) noexcept : heap(heap), writer(writer) {}
+
+    [[nodiscard]] bool empty() const noexcept { return heap.empty(); }
+
+    [[nodiscard]] std::uint64_t top() const { return heap.top(); }
+
+    void push(std::uint64_t value) {
+        writer.record(Operation::kHeapPush, value);
+        heap.push(value);
+    }
+
+    void pop() {
+        writer.record(Operation::kHeapPop);
+        heap.pop();
+    }
+};
+
+// Queue operations on std::uint64_t values, front isn't recorded
+template <typename Q>
+class RecordingQueue {
+private:
+    Q &queue;
+    Writer &writer;
+
+public:
+    RecordingQueue(Q &queue, Writer &writer) noexcept : queue(queue), writer(writer) {}
+
+    [[nodiscard]] bool empty() const noexcept { return queue.empty(); }
+
+    [[nodiscard]] std::uint64_t front() const { return queue.front(); }
+
+    void push(std::uint64_t value) {
+        writer.record(Operation::kQueuePush, value);
+        queue.push(value);
+    }
+
+    void pop() {
+        writer.record(Operation::kQueuePop);
+        queue.pop();
+    }
+};
+
+} // namespace trace
+
+#endif // CUSTOM_DS_TRACE
@@ -0,0 +1,235 @@
+// Records a trace of Map, Heap and Queue operations, or replays one against the repo containers and
+// their std:: equivalents on several memory resources
+// Usage: TraceReplay --record PATH [--requests N]   records the sample session cache below
+//        TraceReplay PATH                           replays a trace
+// Heap.cpp is included because only Heap<int, MoreCompare<int>> is instantiated there
+#include "../Heap/Heap/Heap.cpp"
+#include "../Map/Map.h"
+#include "../MinMaxQueue/Queue/Queue.h"
+#include "../StackArena/StackArena.h"
+#include "Bench.h"
+#include "Trace.h"
+#include "Workload.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace {
+
+using SessionMap = Map<std::uint64_t, std::uint64_t, std::less<std::uint64_t>>;
+// Smallest expiry on top
+using TimerHeap = Heap<std::uint64_t, std::less<std::uint64_t>>;
+
+constexpr std::size_t kDefaultRequests = 1 << 22;
+constexpr std::uint64_t kSessions = 1 << 20;
+constexpr std::uint64_t kSessionBits = 20;
+constexpr std::uint64_t kSessionLifetime = 1 << 16;
+constexpr double kSessionSkew = 0.99;
+
+// Session cache: requests arrive in bursts of 1 to 64 into a queue, for sessions drawn from a Zipf
+// distribution. Serving one looks its session up, creates a missing one and schedules its expiry
+// in a timer heap, and erases every expired session
+void recordSample(const std::string &path, std::size_t requests) {
+    trace::Writer writer(path);
+    SessionMap sessions;
+    TimerHeap timers;
+    Queue<std::uint64_t> arrivals(16);
+    trace::RecordingMap<SessionMap> recorded_sessions(sessions, writer);
+    trace::RecordingHeap<TimerHeap> recorded_timers(timers, writer);
+    trace::RecordingQueue<Queue<std::uint64_t>> recorded_arrivals(arrivals, writer);
+    workload::Zipf popularity(kSessions, kSessionSkew);
+    Random random;
+    std::uint64_t now = 0;
+    while (now < requests) {
+        for (std::uint64_t burst = 1 + random.next(64); burst > 0; --burst) {
+            recorded_arrivals.push(popularity.next(random));
+        }
+        while (!recorded_arrivals.empty()) {
+            std::uint64_t session = recorded_arrivals.front();
+            recorded_arrivals.pop();
+            ++now;
+            if (recorded_sessions.find(session) == sessions.end()) {
+                recorded_sessions.insert(session, now);
+                recorded_timers.push(((now + kSessionLifetime) << kSessionBits) | session);
+            }
+            while (!recorded_timers.empty() && (recorded_timers.top() >> kSessionBits) <= now) {
+                recorded_sessions.erase(recorded_timers.top() & (kSessions - 1));
+                recorded_timers.pop();
+            }
+        }
+    }
+    writer.close();
+    std::printf("Recorded %llu requests into %s\n", static_cast<unsigned long long>(now), path.c_str());
+}
+
+const char *const kPolicies[] = {"new/delete", "pool", "StackArena"};
+
+// Runs run(resource) on a fresh memory resource of the policy
+template <typename Run>
+void withPolicy(std::size_t policy, Run run) {
+    if (policy == 0) {
+        run(std::pmr::new_delete_resource());
+    } else if (policy == 1) {
+        std::pmr::unsynchronized_pool_resource pool;
+        run(&pool);
+    } else {
+        StackArena arena;
+        run(&arena);
+    }
+}
+
+void reportLatencies(std::vector<std::int64_t> &latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double q) {
+        std::size_t index = static_cast<std::size_t>(q * static_cast<double>(latencies.size() - 1));
+        return static_cast<long long>(latencies[index]);
+    };
+    std::printf("%-48s p50 %6lld ns  p99 %6lld ns  p99.9 %8lld ns  max %10lld ns\n", "", percentile(0.5),
+                percentile(0.99), percentile(0.999), static_cast<long long>(latencies.back()));
+}
+
+// One pass without clock reads for the throughput, one with a clock read around every operation
+// for the latencies; each pass starts from an empty container on a fresh resource
+template <typename Make, typename Apply>
+void replay(const std::string &name, const std::vector<trace::Record> &records, Make make, Apply apply) {
+    if (records.empty()) {
+        return;
+    }
+    for (std::size_t policy = 0; policy < std::size(kPolicies); ++policy) {
+        double seconds = 0;
+        withPolicy(policy, [&records, &make, &apply, &seconds](std::pmr::memory_resource *resource) {
+            auto container = make(resource);
+            Timer timer;
+            for (const trace::Record &record : records) {
+                apply(container, record);
+            }
+            seconds = timer.elapsedSeconds();
+        });
+        std::vector<std::int64_t> latencies(records.size());
+        withPolicy(policy, [&records, &make, &apply, &latencies](std::pmr::memory_resource *resource) {
+            auto container = make(resource);
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                Timer timer;
+                apply(container, records[i]);
+                latencies[i] = timer.elapsedNanoseconds();
+            }
+        });
+        report((name + ", " + kPolicies[policy]).c_str(), records.size(), seconds);
+        reportLatencies(latencies);
+    }
+}
+
+[[nodiscard]] std::vector<trace::Record> select(const std::vector<trace::Record> &records, trace::Operation first,
+                                                trace::Operation last) {
+    std::vector<trace::Record> selected;
+    for (const trace::Record &record : records) {
+        if (first <= record.operation && record.operation <= last) {
+            selected.push_back(record);
+        }
+    }
+    return selected;
+}
+
+template <typename M>
+void applyToMap(M &map, const trace::Record &record) {
+    if (record.operation == trace::Operation::kMapInsert) {
+        map.insert({record.key, record.key});
+    } else if (record.operation == trace::Operation::kMapFind) {
+        doNotOptimize(map.find(record.key) != map.end());
+    } else {
+        map.erase(record.key);
+    }
+}
+
+// Pops are skipped on an empty container, a consistent trace never has them
+template <typename H>
+void applyToHeap(H &heap, const trace::Record &record) {
+    if (record.operation == trace::Operation::kHeapPush) {
+        heap.push(record.key);
+    } else if (!heap.empty()) {
+        doNotOptimize(heap.top());
+        heap.pop();
+    }
+}
+
+template <typename Q>
+void applyToQueue(Q &queue, const trace::Record &record) {
+    if (record.operation == trace::Operation::kQueuePush) {
+        queue.push(record.key);
+    } else if (!queue.empty()) {
+        doNotOptimize(queue.front());
+        queue.pop();
+    }
+}
+
+void replayAll(const std::vector<trace::Record> &records) {
+    using StdMap = std::pmr::map<std::uint64_t, std::uint64_t>;
+    using StdHeap = std::priority_queue<std::uint64_t, std::pmr::vector<std::uint64_t>, std::greater<std::uint64_t>>;
+    using StdQueue = std::queue<std::uint64_t, std::pmr::deque<std::uint64_t>>;
+
+    std::vector<trace::Record> map_records =
+        select(records, trace::Operation::kMapInsert, trace::Operation::kMapErase);
+    replay(
+        "Map", map_records, [](std::pmr::memory_resource *resource) { return SessionMap(resource); },
+        applyToMap<SessionMap>);
+    replay(
+        "std::map", map_records, [](std::pmr::memory_resource *resource) { return StdMap(resource); },
+        applyToMap<StdMap>);
+
+    std::vector<trace::Record> heap_records =
+        select(records, trace::Operation::kHeapPush, trace::Operation::kHeapPop);
+    replay(
+        "Heap", heap_records, [](std::pmr::memory_resource *resource) { return TimerHeap(0, resource); },
+        applyToHeap<TimerHeap>);
+    replay(
+        "std::priority_queue", heap_records,
+        [](std::pmr::memory_resource *resource) {
+            return StdHeap(std::greater<std::uint64_t>(), std::pmr::vector<std::uint64_t>(resource));
+        },
+        applyToHeap<StdHeap>);
+
+    std::vector<trace::Record> queue_records =
+        select(records, trace::Operation::kQueuePush, trace::Operation::kQueuePop);
+    replay(
+        "Queue", queue_records,
+        [](std::pmr::memory_resource *resource) { return Queue<std::uint64_t>(16, resource); },
+        applyToQueue<Queue<std::uint64_t>>);
+    replay(
+        "std::queue", queue_records,
+        [](std::pmr::memory_resource *resource) { return StdQueue(std::pmr::deque<std::uint64_t>(resource)); },
+        applyToQueue<StdQueue>);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    try {
+        if (argc >= 3 && std::string(argv[1]) == "--record") {
+            std::size_t requests = kDefaultRequests;
+            if (argc == 5 && std::string(argv[3]) == "--requests") {
+                requests = std::stoull(argv[4]);
+            } else if (argc != 3) {
+                std::fprintf(stderr, "Usage: %s --record PATH [--requests N]\n", argv[0]);
+                return 2;
+            }
+            recordSample(argv[2], requests);
+            return 0;
+        }
+        if (argc != 2) {
+            std::fprintf(stderr, "Usage: %s --record PATH [--requests N] | %s PATH\n", argv[0], argv[0]);
+            return 2;
+        }
+        std::vector<trace::Record> records = trace::read(argv[1]);
+        std::printf("%zu operations in %s\n", records.size(), argv[1]);
+        replayAll(records);
+    } catch (const std::exception &exception) {
+        std::fprintf(stderr, "%s\n", exception.what());
+        return 1;
+    }
+    return 0;
+}
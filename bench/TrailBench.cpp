@@ -0,0 +1,83 @@
+#include "../MinMaxQueue/Stack/Stack.h"
+#include "Bench.h"
+#include <string>
+
+namespace {
+
+// Backtracking search tree: every node records kChanges trail entries, then tries kBranching
+// children down to kDepth, so the trail holds up to kDepth * kChanges entries
+constexpr std::size_t kDepth = 9;
+constexpr std::size_t kBranching = 4;
+constexpr std::size_t kChanges = 4;
+
+template <typename T>
+T makeEntry(std::size_t value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(24, static_cast<char>('a' + value % 26));
+    } else {
+        return static_cast<T>(value);
+    }
+}
+
+// Saves a state as a copy of the whole trail and restores it by assignment
+template <typename T>
+std::size_t searchWithCopies(Stack<T> &trail, std::size_t depth) {
+    if (depth == kDepth) {
+        return trail.getSize();
+    }
+    Stack<T> saved(trail);
+    std::size_t leaves = 0;
+    for (std::size_t child = 0; child < kBranching; ++child) {
+        for (std::size_t i = 0; i < kChanges; ++i) {
+            trail.push(makeEntry<T>(depth * kBranching + child + i));
+        }
+        leaves += searchWithCopies(trail, depth + 1);
+        trail = saved;
+    }
+    return leaves;
+}
+
+template <typename T>
+std::size_t searchWithCheckpoints(Stack<T> &trail, std::size_t depth) {
+    if (depth == kDepth) {
+        return trail.getSize();
+    }
+    std::size_t mark = trail.checkpoint();
+    std::size_t leaves = 0;
+    for (std::size_t child = 0; child < kBranching; ++child) {
+        for (std::size_t i = 0; i < kChanges; ++i) {
+            trail.push(makeEntry<T>(depth * kBranching + child + i));
+        }
+        leaves += searchWithCheckpoints(trail, depth + 1);
+        trail.rollback(mark);
+    }
+    return leaves;
+}
+
+template <typename T>
+void benchSearch(const char *type_name) {
+    std::size_t nodes = 0;
+    for (std::size_t level = 0, width = 1; level <= kDepth; ++level, width *= kBranching) {
+        nodes += width;
+    }
+    Stack<T> copies_trail;
+    Timer timer;
+    std::size_t copies_result = searchWithCopies(copies_trail, 0);
+    report((std::string(type_name) + " trail, copy to save a state").c_str(), nodes, timer.elapsedSeconds());
+
+    Stack<T> checkpoints_trail;
+    timer.reset();
+    std::size_t checkpoints_result = searchWithCheckpoints(checkpoints_trail, 0);
+    report((std::string(type_name) + " trail, checkpoint and rollback").c_str(), nodes, timer.elapsedSeconds());
+    if (copies_result != checkpoints_result) {
+        std::printf("Searches disagree: %zu vs %zu\n", copies_result, checkpoints_result);
+    }
+}
+
+} // namespace
+
+int main() {
+    benchSearch<int>("Stack<int>");
+    benchSearch<std::string>("Stack<std::string>");
+    return 0;
+}
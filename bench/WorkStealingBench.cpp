@@ -0,0 +1,128 @@
+#include "../MinMaxQueue/WorkStealingDeque/WorkStealingDeque.h"
+#include "Bench.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kFibArgument = 38;
+// Below it fib runs sequentially, so a task is big enough to be worth stealing
+constexpr int kSequentialCutoff = 18;
+
+[[nodiscard]] long long sequentialFib(int n) noexcept {
+    return n < 2 ? n : sequentialFib(n - 1) + sequentialFib(n - 2);
+}
+
+struct Task {
+    int n;
+    long long result;
+    std::atomic<bool> done;
+
+    explicit Task(int n) noexcept : n(n), result(0), done(false) {}
+};
+
+// Fork/join runtime: every worker owns a deque, spawns to its bottom, and while it waits for a
+// child it runs its own tasks or steals the oldest task of a random victim
+class Runtime {
+private:
+    std::vector<std::unique_ptr<WorkStealingDeque<Task *>>> deques;
+    std::atomic<bool> finished;
+    std::atomic<std::size_t> steals;
+
+    static inline thread_local std::size_t worker_index = 0;
+
+    bool runOne(Random &random) {
+        std::optional<Task *> task = deques[worker_index]->pop();
+        if (!task) {
+            std::size_t victim = random.next(deques.size());
+            if (victim == worker_index) {
+                return false;
+            }
+            task = deques[victim]->steal();
+            if (!task) {
+                return false;
+            }
+            steals.fetch_add(1, std::memory_order_relaxed);
+        }
+        run(**task, random);
+        return true;
+    }
+
+    void run(Task &task, Random &random) {
+        if (task.n < kSequentialCutoff) {
+            task.result = sequentialFib(task.n);
+        } else {
+            Task child(task.n - 1);
+            deques[worker_index]->push(&child);
+            Task other(task.n - 2);
+            run(other, random);
+            while (!child.done.load(std::memory_order_acquire)) {
+                if (!runOne(random)) {
+                    std::this_thread::yield();
+                }
+            }
+            task.result = child.result + other.result;
+        }
+        task.done.store(true, std::memory_order_release);
+    }
+
+public:
+    explicit Runtime(std::size_t workers_count) : finished(false), steals(0) {
+        for (std::size_t i = 0; i < workers_count; ++i) {
+            deques.push_back(std::make_unique<WorkStealingDeque<Task *>>());
+        }
+    }
+
+    [[nodiscard]] std::size_t getSteals() const noexcept { return steals.load(std::memory_order_relaxed); }
+
+    long long fib(int n) {
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < deques.size(); ++i) {
+            workers.emplace_back([this, i]() {
+                worker_index = i;
+                Random random(i + 1);
+                while (!finished.load(std::memory_order_acquire)) {
+                    if (!runOne(random)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        worker_index = 0;
+        Random random(1);
+        Task root(n);
+        run(root, random);
+        finished.store(true, std::memory_order_release);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        return root.result;
+    }
+};
+
+} // namespace
+
+int main() {
+    Timer timer;
+    long long expected = sequentialFib(kFibArgument);
+    double sequential_seconds = timer.elapsedSeconds();
+    std::printf("%-48s %12.3f ms\n", ("sequential fib(" + std::to_string(kFibArgument) + ")").c_str(),
+                sequential_seconds * 1e3);
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 4) {
+        max_threads = 4;
+    }
+    for (std::size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+        Runtime runtime(threads_count);
+        timer.reset();
+        long long result = runtime.fib(kFibArgument);
+        double seconds = timer.elapsedSeconds();
+        std::printf("%-48s %12.3f ms %8.2fx %10zu steals%s\n",
+                    ("work-stealing fib threads " + std::to_string(threads_count)).c_str(), seconds * 1e3,
+                    sequential_seconds / seconds, runtime.getSteals(), result == expected ? "" : " WRONG");
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#ifndef CUSTOM_DS_WORKLOAD
+#define CUSTOM_DS_WORKLOAD
+#include "Bench.h"
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Key and operation distributions for the benchmarks
+// Keys are generated up front into a vector, so a benchmark times the container and not the
+// generator
+namespace workload {
+
+// Uniform double in [0, 1)
+[[nodiscard]] inline double nextUnit(Random &random) noexcept {
+    return static_cast<double>(random.next() >> 11) * 0x1.0p-53;
+}
+
+// Zipf distribution over ranks [0, n): rank r is drawn with probability proportional to
+// 1 / (r + 1)^skew, skew > 0. Rejection-inversion sampling (Hormann and Derflinger, "Rejection-
+// inversion to generate variates from monotone discrete distributions", 1996) takes O(1) time
+// and memory per draw for any n, where the usual table of harmonic numbers takes O(n)
+class Zipf {
+private:
+    double exponent;
+    double n;
+    double h_integral_x1;
+    double h_integral_n;
+    double squeeze;
+
+    // log1p(x) / x and expm1(x) / x, which stay accurate around x = 0 (skew close to 1)
+    [[nodiscard]] static double log1pOverX(double x) noexcept {
+        return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+    }
+
+    [[nodiscard]] static double expm1OverX(double x) noexcept {
+        return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+    }
+
+    [[nodiscard]] double h(double x) const noexcept { return std::exp(-exponent * std::log(x)); }
+
+    // Integral of h, and its inverse
+    [[nodiscard]] double hIntegral(double x) const noexcept {
+        double log_x = std::log(x);
+        return expm1OverX((1 - exponent) * log_x) * log_x;
+    }
+
+    [[nodiscard]] double hIntegralInverse(double x) const noexcept {
+        double t = x * (1 - exponent);
+        if (t < -1) {
+            t = -1;
+        }
+        return std::exp(log1pOverX(t) * x);
+    }
+
+public:
+    Zipf(std::uint64_t n, double skew) noexcept
+        : exponent(skew), n(static_cast<double>(n)), h_integral_x1(hIntegral(1.5) - 1),
+          h_integral_n(hIntegral(static_cast<double>(n) + 0.5)),
+          squeeze(2 - hIntegralInverse(hIntegral(2.5) - h(2))) {}
+
+    [[nodiscard]] std::uint64_t next(Random &random) const noexcept {
+        while (true) {
+            double u = h_integral_n + nextUnit(random) * (h_integral_x1 - h_integral_n);
+            double x = hIntegralInverse(u);
+            double k = std::floor(x + 0.5);
+            if (k < 1) {
+                k = 1;
+            } else if (k > n) {
+                k = n;
+            }
+            if (k - x <= squeeze || u >= hIntegral(k + 0.5) - h(k)) {
+                return static_cast<std::uint64_t>(k) - 1;
+            }
+        }
+    }
+};
+
+enum class Shape {
+    // Independent keys in [0, range)
+    kUniform,
+    // Ranks in [0, range), rank 0 the most frequent
+    kZipf,
+    // 0, 1, 2, ... in [0, range), the AA tree's worst case: every insert goes to the rightmost leaf
+    // and splits cascade up the right spine
+    kAscending,
+    // range - 1, range - 2, ... every insert goes to the leftmost leaf and needs a skew
+    kDescending,
+    // Ascending runs of period keys, each run falling between the keys of the previous ones, so
+    // keys are distinct and inserts keep landing inside the tree
+    kSawtooth,
+    // Never decreasing, with random gaps of 0 to 7 as event times do; every push into a max-heap
+    // sifts all the way up. range is ignored
+    kTimestamps,
+};
+
+struct Distribution {
+    Shape shape;
+    // kZipf only
+    double skew;
+    // kSawtooth only
+    std::uint64_t period;
+
+    [[nodiscard]] static Distribution uniform() noexcept { return {Shape::kUniform, 0, 0}; }
+
+    [[nodiscard]] static Distribution zipf(double skew) noexcept { return {Shape::kZipf, skew, 0}; }
+
+    [[nodiscard]] static Distribution ascending() noexcept { return {Shape::kAscending, 0, 0}; }
+
+    [[nodiscard]] static Distribution descending() noexcept { return {Shape::kDescending, 0, 0}; }
+
+    [[nodiscard]] static Distribution sawtooth(std::uint64_t period) noexcept { return {Shape::kSawtooth, 0, period}; }
+
+    [[nodiscard]] static Distribution timestamps() noexcept { return {Shape::kTimestamps, 0, 0}; }
+
+    [[nodiscard]] std::string name() const {
+        switch (shape) {
+        case Shape::kUniform:
+            return "uniform";
+        case Shape::kZipf: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "zipf %.2f", skew);
+            return buffer;
+        }
+        case Shape::kAscending:
+            return "ascending";
+        case Shape::kDescending:
+            return "descending";
+        case Shape::kSawtooth:
+            return "sawtooth " + std::to_string(period);
+        case Shape::kTimestamps:
+            return "timestamps";
+        }
+        return "";
+    }
+};
+
+// count keys of the distribution, range > 0
+[[nodiscard]] inline std::vector<std::uint64_t> generate(const Distribution &distribution, std::size_t count,
+                                                        std::uint64_t range, std::uint64_t seed = 1) {
+    std::vector<std::uint64_t> keys(count);
+    Random random(seed);
+    switch (distribution.shape) {
+    case Shape::kUniform:
+        for (std::uint64_t &key : keys) {
+            key = random.next(range);
+        }
+        break;
+    case Shape::kZipf: {
+        Zipf zipf(range, distribution.skew);
+        for (std::uint64_t &key : keys) {
+            key = zipf.next(random);
+        }
+        break;
+    }
+    case Shape::kAscending:
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = i % range;
+        }
+        break;
+    case Shape::kDescending:
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = range - 1 - i % range;
+        }
+        break;
+    case Shape::kSawtooth: {
+        std::uint64_t runs = (count + distribution.period - 1) / distribution.period;
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = ((i % distribution.period) * runs + i / distribution.period) % range;
+        }
+        break;
+    }
+    case Shape::kTimestamps: {
+        std::uint64_t now = 0;
+        for (std::uint64_t &key : keys) {
+            now += random.next(8);
+            key = now;
+        }
+        break;
+    }
+    }
+    return keys;
+}
+
+// Picks operation i with probability weights[i] / sum of weights
+class OperationMix {
+private:
+    std::vector<std::uint64_t> thresholds;
+    Random random;
+
+public:
+    OperationMix(std::initializer_list<unsigned int> weights, std::uint64_t seed = 1) : random(seed) {
+        std::uint64_t sum = 0;
+        for (unsigned int weight : weights) {
+            sum += weight;
+            thresholds.push_back(sum);
+        }
+    }
+
+    [[nodiscard]] std::size_t next() noexcept {
+        std::uint64_t value = random.next(thresholds.back());
+        std::size_t operation = 0;
+        while (value >= thresholds[operation]) {
+            ++operation;
+        }
+        return operation;
+    }
+};
+
+} // namespace workload
+
+#endif // CUSTOM_DS_WORKLOAD